@@ -0,0 +1,101 @@
+/*
+ * File:   comLog.c
+ *
+ * Created on October 17, 2026
+ *-----------------------------------------------------------------------
+ * Logging over the COM port (USART2) that doesn't hold up playback.
+ * Formatted text is queued in a ring and sent by the USART2 transmit
+ * interrupt, at low priority, see comLog.h.
+ *-----------------------------------------------------------------------*/
+
+#include <xc.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include "comLog.h"
+
+#if comBufSize != 256
+#error comBufSize must be 256, the ring indices wrap as bytes
+#endif
+#if comLineLen > comBufSize
+#error comLineLen must fit in the ring, lengths are counted in bytes
+#endif
+
+/* Ring of characters waiting to be sent.  comHead is only written by
+ * comPrintf and comTail only by the ISR, one byte is always left empty. */
+static char comBuf[comBufSize];
+static volatile BYTE comHead;       // Next character to queue
+static volatile BYTE comTail;       // Next character to send
+
+WORD comDropped;
+
+
+
+/*-----------------------------------------------------------------------
+ * Queue the 'n' characters at 's' and have the ISR send them.  They are
+ * all dropped if they don't all fit, so no line is ever cut.  Returns 0
+ * if they were dropped.
+ *-----------------------------------------------------------------------*/
+static BYTE comQueue(const char* s, BYTE n)
+{
+    BYTE head = comHead;
+
+    if ((BYTE)(comTail - head - 1) < n) {   // Not enough room
+        comDropped += n;
+        return 0;
+    }
+    while (n--) comBuf[head++] = *s++;
+    comHead = head;
+    PIE3bits.TX2IE = 1;         // Interrupts as soon as the USART can take a character
+    return 1;
+}
+
+/*-----------------------------------------------------------------------
+ * printf to the COM port without waiting for it.  The text is formatted
+ * and copied into the ring, which takes microseconds rather than the
+ * milliseconds printf takes to send a line.  A line is at most
+ * comLineLen - 1 characters, longer ones are cut short.  Not for use in
+ * an ISR.
+ *-----------------------------------------------------------------------*/
+void comPrintf(const char* fmt, ...)
+{
+    static char line[comLineLen];
+    va_list ap;
+    WORD dropped = comDropped;
+    int n;
+
+    // Say how much was lost before going on
+    if (dropped) {
+        n = snprintf(line, sizeof(line), "<%u dropped>\n\r", dropped);
+        comDropped = 0;
+        if (!comQueue(line, (BYTE)n)) comDropped = dropped;   // Still no room, say it later
+    }
+
+    // vsnprintf returns the length the whole line would have had
+    va_start(ap, fmt);
+    n = vsnprintf(line, sizeof(line), fmt, ap);
+    va_end(ap);
+    if (n < 0) return;
+    if (n > comLineLen - 1) n = comLineLen - 1;
+    comQueue(line, (BYTE)n);
+}
+
+/*-----------------------------------------------------------------------
+ *                   ******* Low priority ISR *******
+ * USART2 transmit interrupt: send the next character queued, or turn the
+ * interrupt off when they have all gone.  Everything but the sample tick
+ * is low priority (see init_COM), so the tick can cut in here at any
+ * point.  Further low priority sources are serviced here too.
+ *-----------------------------------------------------------------------*/
+void interrupt low_priority comInterrupt(void)
+{
+    if (PIE3bits.TX2IE && PIR3bits.TX2IF) {
+        BYTE tail = comTail;
+
+        if (tail == comHead) {
+            PIE3bits.TX2IE = 0;     // Ring is empty
+            return;
+        }
+        TXREG2 = comBuf[tail++];
+        comTail = tail;
+    }
+}
@@ -0,0 +1,37 @@
+/*
+ * File:   comLog.h
+ *
+ * Created on October 17, 2026
+ */
+
+#ifndef COMLOG_H
+#define	COMLOG_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+#include "integer.h"
+
+/* Text logged with comPrintf waits in a ring of comBufSize bytes and is
+ * shifted out of USART2 by its transmit interrupt, so logging never waits
+ * on the COM port (a character takes 260 us at 38400 baud).  The ring
+ * indices are single bytes, so comBufSize must be 256.  Text that doesn't
+ * fit is dropped and counted, and the count is logged once there is room
+ * again.  comLineLen is the longest line comPrintf can format. */
+#define comBufSize 256
+#define comLineLen 64
+
+extern WORD comDropped;     // Characters dropped since the count was last logged
+
+/*---------------------------------------*/
+/* Prototypes for COM port logging functions */
+void comPrintf(const char* fmt, ...);
+void interrupt low_priority comInterrupt(void);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* COMLOG_H */
+
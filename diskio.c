@@ -6,6 +6,7 @@
 #include <spi.h>
 #include <stdio.h>
 #include "diskio.h"
+#include "pffconf.h"
 
 #define SELECT()    LATC2 = 0
 #define DESELECT()  LATC2 = 1
@@ -15,8 +16,10 @@
 #define CMD1	(0x40+1)	/* SEND_OP_COND (MMC) */
 #define	ACMD41	(0xC0+41)	/* SEND_OP_COND (SDC) */
 #define CMD8	(0x40+8)	/* SEND_IF_COND */
+#define CMD12	(0x40+12)	/* STOP_TRANSMISSION */
 #define CMD16	(0x40+16)	/* SET_BLOCKLEN */
 #define CMD17	(0x40+17)	/* READ_SINGLE_BLOCK */
+#define CMD18	(0x40+18)	/* READ_MULTIPLE_BLOCK */
 #define CMD24	(0x40+24)	/* WRITE_BLOCK */
 #define CMD55	(0x40+55)	/* APP_CMD */
 #define CMD58	(0x40+58)	/* READ_OCR */
@@ -30,6 +33,12 @@
 
 static BYTE CardType;
 
+/* Multiple block read session (disk_readm) */
+static BYTE StreamOpen;		/* 1:CMD18 is in progress and the card is selected */
+static BYTE StreamWait;		/* 1:Data token of StreamSect is not received yet */
+static DWORD StreamSect;	/* Sector the session is positioned in */
+static UINT StreamOfs;		/* Number of bytes of StreamSect already received */
+
 /*-----------------------------------------------------------------------
  * Initialize SPI 1 at a slow speed to begin talking to the SD card.
  *-----------------------------------------------------------------------*/
@@ -110,11 +119,13 @@ BYTE cmd_xfer (
 {
 	BYTE n, res;
 
-	/* Select the card */
-	DESELECT();
-	read_spi();
-	SELECT();
-	read_spi();
+	/* Select the card (CMD12 is sent while the card is selected for the data transfer) */
+	if (cmd != CMD12) {
+		DESELECT();
+		read_spi();
+		SELECT();
+		read_spi();
+	}
 
 	/* Send a command packet */
 	write_spi(cmd);						/* Start + Command index */
@@ -126,6 +137,7 @@ BYTE cmd_xfer (
 	if (cmd == CMD0) n = 0x95;			/* Valid CRC for CMD0(0) */
 	if (cmd == CMD8) n = 0x87;			/* Valid CRC for CMD8(0x1AA) */
 	write_spi(n);
+	if (cmd == CMD12) read_spi();		/* Discard a stuff byte following CMD12 */
 
 	/* Receive a command response */
 	n = 10;								/* Wait for a valid response in timeout of 10 attempts */
@@ -178,6 +190,7 @@ DSTATUS disk_initialize (void)
 		}
 	}
 	CardType = ty;
+	StreamOpen = 0;
 	DESELECT();
 	read_spi();
 
@@ -202,6 +215,8 @@ DRESULT disk_readp (
 	UINT bc;
 
 
+	if (StreamOpen) disk_readm_stop();		/* Terminate multiple block read session */
+
 	if (!(CardType & CT_BLOCK)) sector *= 512;	/* Convert to byte address if needed */
 
 	res = RES_ERROR;
@@ -225,6 +240,14 @@ DRESULT disk_readp (
 				do {
 					*buff++ = read_spi();
 				} while (--count);
+			} else {	/* Forward data to the outgoing stream */
+				do {
+#if _USE_FORWARD
+					FORWARD(read_spi());
+#else
+					read_spi();
+#endif
+				} while (--count);
 			}
 
 			/* Skip remaining bytes and CRC */
@@ -241,33 +264,154 @@ DRESULT disk_readp (
 }
 
 
-#ifdef _USE_WRITE
+
+
+/*-----------------------------------------------------------------------*/
+/* Read Partial Sector in a Multiple Block Read Session                  */
+/*-----------------------------------------------------------------------*/
+/* Same as disk_readp(), but the card is left in a CMD18 session after   */
+/* the call.  A following call that continues at the same position (the  */
+/* next bytes of the sector, or the top of the next sector) receives the */
+/* data without any command, token wait or re-addressing overhead.  Any  */
+/* other position terminates the session and starts a new one.           */
+
+DRESULT disk_readm (
+	BYTE* buff,		/* Pointer to the destination object (NULL:Forward data) */
+	DWORD sector,	/* Sector number (LBA) */
+	UINT offset,	/* Offset in the sector */
+	UINT count		/* Byte count (1..512-offset) */
+)
+{
+	BYTE rc;
+	UINT bc;
+
+
+	if (StreamOpen && (sector != StreamSect || offset < StreamOfs))
+		disk_readm_stop();				/* Not a continuation of the session */
+
+	if (!StreamOpen) {					/* Start a new session */
+		if (send_cmd(CMD18, (CardType & CT_BLOCK) ? sector : sector * 512) != 0) {	/* READ_MULTIPLE_BLOCK */
+			DESELECT();
+			read_spi();
+			return RES_ERROR;
+		}
+		StreamOpen = 1;
+		StreamWait = 1;
+		StreamSect = sector;
+		StreamOfs = 0;
+	}
+
+	if (StreamWait) {					/* Wait for the data packet of this sector */
+		bc = 40000;
+		do {
+			rc = read_spi();
+		} while (rc == 0xFF && --bc);
+		if (rc != 0xFE) {
+			disk_readm_stop();
+			return RES_ERROR;
+		}
+		StreamWait = 0;
+	}
+
+	/* Skip leading bytes */
+	for (bc = offset - StreamOfs; bc; bc--) read_spi();
+
+	/* Receive a part of the sector */
+	StreamOfs = offset + count;
+	if (buff) {	/* Store data to the memory */
+		do {
+			*buff++ = read_spi();
+		} while (--count);
+	} else {	/* Forward data to the outgoing stream */
+		do {
+#if _USE_FORWARD
+			FORWARD(read_spi());
+#else
+			read_spi();
+#endif
+		} while (--count);
+	}
+
+	if (StreamOfs >= 512) {				/* End of the data block */
+		read_spi();						/* Skip CRC */
+		read_spi();
+		StreamSect++;					/* Next data packet follows */
+		StreamOfs = 0;
+		StreamWait = 1;
+	}
+
+	return RES_OK;
+}
+
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Terminate the Multiple Block Read Session                             */
+/*-----------------------------------------------------------------------*/
+
+void disk_readm_stop (void)
+{
+	UINT bc;
+
+
+	if (!StreamOpen) return;
+	StreamOpen = 0;
+
+	if (send_cmd(CMD12, 0) == 0) {		/* STOP_TRANSMISSION */
+		bc = 40000;
+		while (read_spi() != 0xFF && --bc) ;	/* Wait for end of busy state */
+	}
+
+	DESELECT();
+	read_spi();
+}
+
+
+#if _USE_WRITE
 /*-----------------------------------------------------------------------*/
 /* Write Partial Sector                                                  */
 /*-----------------------------------------------------------------------*/
 
 DRESULT disk_writep (
-	BYTE* buff,		/* Pointer to the data to be written, NULL:Initiate/Finalize write operation */
+	const BYTE* buff,	/* Pointer to the data to be written, NULL:Initiate/Finalize write operation */
 	DWORD sc		/* Sector number (LBA) or Number of bytes to send */
 )
 {
 	DRESULT res;
+	UINT bc;
+	static UINT wc;		/* Bytes left to send in the data block */
 
 
-	if (!buff) {
-		if (sc) {
-
-			// Initiate write process
-
-		} else {
-
-			// Finalize write process
+	res = RES_ERROR;
 
+	if (buff) {		/* Send data bytes */
+		bc = (UINT)sc;
+		while (bc && wc) {		/* Send data bytes to the card */
+			write_spi(*buff++);
+			wc--; bc--;
 		}
+		res = RES_OK;
 	} else {
-
-		// Send data to the disk
-
+		if (sc) {	/* Initiate sector write process */
+			if (StreamOpen) disk_readm_stop();	/* Terminate multiple block read session */
+			if (!(CardType & CT_BLOCK)) sc *= 512;	/* Convert to byte address if needed */
+			if (send_cmd(CMD24, sc) == 0) {			/* WRITE_SINGLE_BLOCK */
+				write_spi(0xFF); write_spi(0xFE);	/* Data block header */
+				wc = 512;							/* Set byte counter */
+				res = RES_OK;
+			}
+		} else {	/* Finalize sector write process */
+			bc = wc + 2;
+			while (bc--) write_spi(0);	/* Fill left bytes and CRC with zeros */
+			if ((read_spi() & 0x1F) == 0x05) {	/* Receive data resp and wait for end of write process in timeout of 500ms */
+				for (bc = 5000; read_spi() != 0xFF && bc; bc--)	/* Wait for ready */
+					dly_100us();
+				if (bc) res = RES_OK;
+			}
+			DESELECT();
+			read_spi();
+		}
 	}
 
 	return res;
@@ -35,8 +35,15 @@ static BYTE send_cmd(BYTE cmd, DWORD arg);
 static BYTE cmd_xfer(BYTE cmd, DWORD arg);
 DSTATUS disk_initialize (void);
 DRESULT disk_readp (BYTE* buff, DWORD sector, UINT offser, UINT count);
+DRESULT disk_readm (BYTE* buff, DWORD sector, UINT offset, UINT count);
+void disk_readm_stop (void);
 DRESULT disk_writep (const BYTE* buff, DWORD sc);
 
+/* Host backend only (diskio_host.c) */
+void disk_host_image (const char* path);
+void disk_host_latency (DWORD us);
+void disk_host_stats (DWORD* ncmd, DWORD* nspi);
+
 #define STA_NOINIT		0x01	/* Drive not initialized */
 #define STA_NODISK		0x02	/* No medium in the drive */
 
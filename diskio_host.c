@@ -0,0 +1,304 @@
+/*-----------------------------------------------------------------------*/
+/* Host disk I/O module for Petit FatFs                                  */
+/*-----------------------------------------------------------------------*/
+/* Serves sectors from a raw FAT12/16/32 image file instead of the SD    */
+/* card so that pff.c can be run and profiled on a PC.  Build this file  */
+/* in place of diskio.c.  The image is read with pread(), or mapped with */
+/* mmap() when _HOST_MMAP is 1.  Every card command can be given an      */
+/* artificial latency, and the number of commands and of bytes the SPI   */
+/* driver would have clocked for them are counted.  Sector writes go     */
+/* back to the image when it can be opened for writing.                  */
+/*-----------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "diskio.h"
+#include "pffconf.h"
+
+#ifndef _HOST_MMAP
+#define _HOST_MMAP	1	/* 1:Map the image into memory, 0:Read it with pread() */
+#endif
+
+#if _HOST_MMAP
+#include <sys/mman.h>
+#endif
+
+/* SPI bytes clocked by diskio.c for each part of a transaction */
+#define SPI_CMD		10	/* Select + command packet + response + deselect */
+#define SPI_TOKEN	1	/* Data token (without card latency) */
+#define SPI_CRC		2	/* CRC following a data block */
+#define SPI_STOP	9	/* CMD12 + stuff byte + response + busy release */
+#define SPI_WTOKEN	2	/* Stuff byte + data token before a written block */
+#define SPI_WRESP	2	/* Data response + busy release after it */
+
+
+static const char *ImagePath;	/* Path of the image file (NULL:Use $PFF_IMAGE) */
+static int ImageFd = -1;
+static BYTE ImageRW;			/* 1:The image is writable */
+static DWORD ImageSects;		/* Number of sectors in the image */
+#if _HOST_MMAP
+static BYTE *ImageMap;
+#endif
+
+static DWORD CmdLatency;		/* Latency added to each command [us] */
+static DWORD NumCmd;			/* Number of commands issued */
+static DWORD NumSpi;			/* Number of bytes clocked on the SPI bus */
+
+/* Multiple block read session (disk_readm) */
+static BYTE StreamOpen;
+static DWORD StreamSect;
+static UINT StreamOfs;
+
+/* Single block write (disk_writep) */
+static DWORD WriteSect;
+static UINT WriteCnt;			/* Bytes of the data block received */
+static BYTE WriteBuf[512];
+
+
+/*-----------------------------------------------------------------------
+ * Account for one card command and apply the injected latency.
+ *-----------------------------------------------------------------------*/
+static void host_cmd (UINT spi)
+{
+	struct timespec ts;
+
+
+	NumCmd++;
+	NumSpi += spi;
+	if (CmdLatency) {
+		ts.tv_sec = CmdLatency / 1000000;
+		ts.tv_nsec = (long)(CmdLatency % 1000000) * 1000;
+		nanosleep(&ts, 0);
+	}
+}
+
+/*-----------------------------------------------------------------------
+ * Copy 'count' bytes at 'offset' of 'sector' from the image.
+ *-----------------------------------------------------------------------*/
+static int host_read (BYTE* buff, DWORD sector, UINT offset, UINT count)
+{
+	if (sector >= ImageSects) return 0;
+	if (!buff) {						/* Forward data to the outgoing stream */
+#if _USE_FORWARD
+		BYTE tmp[512], *p;
+
+		if (!host_read(tmp, sector, offset, count)) return 0;
+		for (p = tmp; count; count--) FORWARD(*p++);
+#endif
+		return 1;
+	}
+#if _HOST_MMAP
+	memcpy(buff, ImageMap + (off_t)sector * 512 + offset, count);
+	return 1;
+#else
+	return pread(ImageFd, buff, count, (off_t)sector * 512 + offset) == (ssize_t)count;
+#endif
+}
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Select the Image File and Command Latency                             */
+/*-----------------------------------------------------------------------*/
+
+void disk_host_image (
+	const char* path	/* Path of the image file served by disk_initialize() */
+)
+{
+	ImagePath = path;
+}
+
+
+void disk_host_latency (
+	DWORD us			/* Latency added to each card command [us] */
+)
+{
+	CmdLatency = us;
+}
+
+
+void disk_host_stats (
+	DWORD* ncmd,		/* Number of card commands issued */
+	DWORD* nspi			/* Number of bytes the SPI driver would have clocked */
+)
+{
+	*ncmd = NumCmd;
+	*nspi = NumSpi;
+	NumCmd = NumSpi = 0;
+}
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Initialize Disk Drive                                                 */
+/*-----------------------------------------------------------------------*/
+
+DSTATUS disk_initialize (void)
+{
+	const char *path = ImagePath ? ImagePath : getenv("PFF_IMAGE");
+	struct stat st;
+
+
+	if (ImageFd >= 0) {					/* Release the previous image */
+#if _HOST_MMAP
+		munmap(ImageMap, (size_t)ImageSects * 512);
+#endif
+		close(ImageFd);
+		ImageFd = -1;
+	}
+	StreamOpen = 0;
+
+	if (!path) return STA_NOINIT | STA_NODISK;
+	ImageRW = 1;
+	if ((ImageFd = open(path, O_RDWR)) < 0) {	/* Fall back to a read-only image */
+		ImageRW = 0;
+		if ((ImageFd = open(path, O_RDONLY)) < 0)
+			return STA_NOINIT | STA_NODISK;
+	}
+	if (fstat(ImageFd, &st) || st.st_size < 512) {
+		close(ImageFd);
+		ImageFd = -1;
+		return STA_NOINIT;
+	}
+	ImageSects = (DWORD)(st.st_size / 512);
+#if _HOST_MMAP
+	ImageMap = mmap(0, (size_t)ImageSects * 512, ImageRW ? PROT_READ | PROT_WRITE : PROT_READ,
+				   MAP_SHARED, ImageFd, 0);
+	if (ImageMap == MAP_FAILED) {
+		close(ImageFd);
+		ImageFd = -1;
+		return STA_NOINIT;
+	}
+#endif
+
+	return 0;
+}
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Read Partial Sector                                                   */
+/*-----------------------------------------------------------------------*/
+
+DRESULT disk_readp (
+	BYTE* buff,		/* Pointer to the destination object (NULL:Forward data) */
+	DWORD sector,	/* Sector number (LBA) */
+	UINT offset,	/* Offset in the sector */
+	UINT count		/* Byte count */
+)
+{
+	if (StreamOpen) disk_readm_stop();		/* Terminate multiple block read session */
+	if (ImageFd < 0) return RES_NOTRDY;
+
+	host_cmd(SPI_CMD + SPI_TOKEN + 512 + SPI_CRC);	/* CMD17 always clocks the whole block */
+
+	return host_read(buff, sector, offset, count) ? RES_OK : RES_ERROR;
+}
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Read Partial Sector in a Multiple Block Read Session                  */
+/*-----------------------------------------------------------------------*/
+
+DRESULT disk_readm (
+	BYTE* buff,		/* Pointer to the destination object (NULL:Forward data) */
+	DWORD sector,	/* Sector number (LBA) */
+	UINT offset,	/* Offset in the sector */
+	UINT count		/* Byte count (1..512-offset) */
+)
+{
+	if (ImageFd < 0) return RES_NOTRDY;
+
+	if (StreamOpen && (sector != StreamSect || offset < StreamOfs))
+		disk_readm_stop();				/* Not a continuation of the session */
+
+	if (!StreamOpen) {					/* CMD18 */
+		host_cmd(SPI_CMD);
+		StreamOpen = 1;
+		StreamSect = sector;
+		StreamOfs = 0;
+	}
+	if (StreamOfs == 0) NumSpi += SPI_TOKEN;
+
+	if (!host_read(buff, sector, offset, count)) {
+		disk_readm_stop();
+		return RES_ERROR;
+	}
+	NumSpi += offset + count - StreamOfs;
+	StreamOfs = offset + count;
+
+	if (StreamOfs >= 512) {				/* End of the data block */
+		NumSpi += SPI_CRC;
+		StreamSect++;
+		StreamOfs = 0;
+	}
+
+	return RES_OK;
+}
+
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Terminate the Multiple Block Read Session                             */
+/*-----------------------------------------------------------------------*/
+
+void disk_readm_stop (void)
+{
+	if (!StreamOpen) return;
+	StreamOpen = 0;
+
+	host_cmd(SPI_STOP);					/* CMD12 */
+}
+
+
+
+#if _USE_WRITE
+/*-----------------------------------------------------------------------*/
+/* Write Partial Sector                                                  */
+/*-----------------------------------------------------------------------*/
+/* The data block is collected and written to the image when it is       */
+/* finalized.  Like the card, the rest of the sector is filled with 0.   */
+
+DRESULT disk_writep (
+	const BYTE* buff,	/* Pointer to the data to be written, NULL:Initiate/Finalize write operation */
+	DWORD sc		/* Sector number (LBA) or Number of bytes to send */
+)
+{
+	if (ImageFd < 0) return RES_NOTRDY;
+
+	if (buff) {		/* Send data bytes */
+		if (sc > 512 - WriteCnt) sc = 512 - WriteCnt;
+		memcpy(WriteBuf + WriteCnt, buff, sc);
+		WriteCnt += (UINT)sc;
+		NumSpi += sc;
+		return RES_OK;
+	}
+
+	if (sc) {		/* Initiate sector write process (CMD24) */
+		if (StreamOpen) disk_readm_stop();
+		if (!ImageRW || sc >= ImageSects) return RES_ERROR;
+		host_cmd(SPI_CMD + SPI_WTOKEN);
+		WriteSect = sc;
+		WriteCnt = 0;
+		return RES_OK;
+	}
+
+	/* Finalize sector write process */
+	NumSpi += 512 - WriteCnt + SPI_CRC + SPI_WRESP;
+	memset(WriteBuf + WriteCnt, 0, 512 - WriteCnt);
+	WriteCnt = 512;
+#if _HOST_MMAP
+	memcpy(ImageMap + (off_t)WriteSect * 512, WriteBuf, 512);
+	return RES_OK;
+#else
+	return pwrite(ImageFd, WriteBuf, 512, (off_t)WriteSect * 512) == 512 ? RES_OK : RES_ERROR;
+#endif
+}
+#endif
@@ -0,0 +1,301 @@
+/*
+ * File:   flashClips.c
+ *
+ * Generated by flashClips.py chime.wav beep.wav, do not edit.
+ * Samples of the clips played from program flash, as in the data
+ * chunk of each file.
+ */
+
+#include <xc.h>
+#include "waveReader.h"
+#include "flashClips.h"
+
+// chime.wav: 8-bit, 11025 Hz, 3528 samples
+static const BYTE clip0Data[3528] = {
+    0x80, 0x81, 0x82, 0x84, 0x86, 0x88, 0x88, 0x86, 0x82, 0x7D, 0x77, 0x71, 0x6D, 0x6B, 0x6D, 0x72,
+    0x79, 0x83, 0x8D, 0x97, 0x9E, 0xA1, 0xA0, 0x9A, 0x8F, 0x81, 0x72, 0x64, 0x59, 0x53, 0x53, 0x5A,
+    0x66, 0x77, 0x8B, 0x9E, 0xAE, 0xB7, 0xBA, 0xB4, 0xA7, 0x93, 0x7B, 0x64, 0x4F, 0x40, 0x3A, 0x3E,
+    0x4B, 0x60, 0x7B, 0x98, 0xB2, 0xC6, 0xD0, 0xD0, 0xC3, 0xAD, 0x90, 0x72, 0x55, 0x3E, 0x31, 0x2F,
+    0x38, 0x4B, 0x65, 0x83, 0xA1, 0xBA, 0xCA, 0xD1, 0xCC, 0xBC, 0xA4, 0x88, 0x6A, 0x4F, 0x3C, 0x31,
+    0x32, 0x3E, 0x53, 0x6E, 0x8B, 0xA7, 0xBD, 0xCB, 0xCE, 0xC6, 0xB5, 0x9C, 0x7F, 0x63, 0x4B, 0x3A,
+    0x33, 0x37, 0x45, 0x5B, 0x76, 0x93, 0xAD, 0xC0, 0xCB, 0xCB, 0xC1, 0xAD, 0x94, 0x78, 0x5D, 0x47,
+    0x39, 0x35, 0x3B, 0x4B, 0x63, 0x7E, 0x9A, 0xB2, 0xC2, 0xCA, 0xC7, 0xBB, 0xA6, 0x8C, 0x70, 0x57,
+    0x44, 0x39, 0x38, 0x41, 0x53, 0x6B, 0x86, 0xA0, 0xB6, 0xC4, 0xC8, 0xC3, 0xB4, 0x9E, 0x84, 0x69,
+    0x52, 0x41, 0x39, 0x3B, 0x47, 0x5A, 0x73, 0x8D, 0xA5, 0xB9, 0xC4, 0xC6, 0xBE, 0xAD, 0x96, 0x7D,
+    0x63, 0x4E, 0x40, 0x3B, 0x3F, 0x4D, 0x61, 0x7A, 0x93, 0xAA, 0xBB, 0xC3, 0xC2, 0xB8, 0xA6, 0x8F,
+    0x76, 0x5E, 0x4B, 0x40, 0x3D, 0x44, 0x53, 0x69, 0x81, 0x99, 0xAE, 0xBC, 0xC2, 0xBF, 0xB2, 0x9F,
+    0x88, 0x6F, 0x59, 0x49, 0x40, 0x40, 0x49, 0x5A, 0x70, 0x88, 0x9F, 0xB1, 0xBD, 0xC0, 0xBA, 0xAC,
+    0x98, 0x81, 0x6A, 0x55, 0x47, 0x41, 0x43, 0x4E, 0x60, 0x77, 0x8E, 0xA3, 0xB4, 0xBD, 0xBE, 0xB6,
+    0xA6, 0x92, 0x7B, 0x64, 0x52, 0x46, 0x43, 0x47, 0x54, 0x67, 0x7D, 0x94, 0xA7, 0xB5, 0xBC, 0xBA,
+    0xB1, 0xA0, 0x8B, 0x75, 0x60, 0x50, 0x46, 0x45, 0x4C, 0x5A, 0x6D, 0x83, 0x99, 0xAB, 0xB6, 0xBB,
+    0xB7, 0xAB, 0x9A, 0x85, 0x6F, 0x5C, 0x4E, 0x47, 0x48, 0x51, 0x60, 0x74, 0x89, 0x9D, 0xAD, 0xB7,
+    0xB9, 0xB3, 0xA6, 0x93, 0x7F, 0x6A, 0x59, 0x4D, 0x48, 0x4B, 0x56, 0x66, 0x7A, 0x8E, 0xA1, 0xAF,
+    0xB6, 0xB6, 0xAE, 0xA0, 0x8D, 0x79, 0x66, 0x56, 0x4C, 0x4A, 0x4F, 0x5B, 0x6C, 0x80, 0x93, 0xA4,
+    0xB0, 0xB5, 0xB3, 0xA9, 0x9A, 0x88, 0x74, 0x62, 0x54, 0x4D, 0x4C, 0x53, 0x60, 0x72, 0x85, 0x98,
+    0xA7, 0xB1, 0xB4, 0xAF, 0xA4, 0x95, 0x82, 0x6F, 0x5F, 0x53, 0x4E, 0x4F, 0x58, 0x66, 0x77, 0x8A,
+    0x9B, 0xA9, 0xB0, 0xB1, 0xAB, 0x9F, 0x8F, 0x7D, 0x6B, 0x5C, 0x52, 0x4F, 0x52, 0x5C, 0x6B, 0x7D,
+    0x8F, 0x9E, 0xAA, 0xB0, 0xAF, 0xA7, 0x9A, 0x8A, 0x78, 0x67, 0x5A, 0x52, 0x51, 0x56, 0x61, 0x70,
+    0x82, 0x93, 0xA1, 0xAB, 0xAE, 0xAC, 0xA3, 0x95, 0x85, 0x74, 0x64, 0x59, 0x53, 0x53, 0x5A, 0x66,
+    0x75, 0x86, 0x96, 0xA3, 0xAB, 0xAD, 0xA8, 0x9E, 0x90, 0x80, 0x70, 0x62, 0x58, 0x54, 0x56, 0x5E,
+    0x6B, 0x7A, 0x8A, 0x99, 0xA4, 0xAA, 0xAB, 0xA5, 0x9A, 0x8B, 0x7C, 0x6C, 0x60, 0x58, 0x56, 0x59,
+    0x62, 0x6F, 0x7F, 0x8E, 0x9C, 0xA5, 0xAA, 0xA8, 0xA1, 0x95, 0x87, 0x77, 0x69, 0x5E, 0x58, 0x57,
+    0x5D, 0x66, 0x74, 0x83, 0x92, 0x9E, 0xA6, 0xA8, 0xA5, 0x9D, 0x91, 0x83, 0x74, 0x67, 0x5D, 0x59,
+    0x5A, 0x60, 0x6B, 0x78, 0x87, 0x94, 0x9F, 0xA5, 0xA6, 0xA2, 0x99, 0x8D, 0x7E, 0x71, 0x65, 0x5D,
+    0x5A, 0x5C, 0x64, 0x6F, 0x7C, 0x8A, 0x97, 0xA0, 0xA5, 0xA4, 0x9F, 0x95, 0x88, 0x7B, 0x6E, 0x63,
+    0x5D, 0x5C, 0x5F, 0x67, 0x73, 0x80, 0x8E, 0x99, 0xA1, 0xA4, 0xA2, 0x9B, 0x91, 0x84, 0x77, 0x6B,
+    0x62, 0x5E, 0x5E, 0x62, 0x6B, 0x77, 0x84, 0x90, 0x9A, 0xA1, 0xA2, 0x9F, 0x98, 0x8D, 0x81, 0x74,
+    0x69, 0x62, 0x5E, 0x60, 0x66, 0x6F, 0x7B, 0x87, 0x93, 0x9B, 0xA0, 0xA1, 0x9C, 0x94, 0x89, 0x7D,
+    0x72, 0x68, 0x62, 0x60, 0x62, 0x69, 0x73, 0x7E, 0x8A, 0x94, 0x9C, 0x9F, 0x9F, 0x99, 0x91, 0x86,
+    0x7A, 0x6F, 0x67, 0x62, 0x61, 0x65, 0x6C, 0x76, 0x82, 0x8D, 0x96, 0x9C, 0x9E, 0x9C, 0x96, 0x8D,
+    0x83, 0x77, 0x6E, 0x66, 0x63, 0x63, 0x68, 0x6F, 0x7A, 0x84, 0x8F, 0x97, 0x9C, 0x9D, 0x9A, 0x93,
+    0x8A, 0x80, 0x75, 0x6C, 0x66, 0x64, 0x65, 0x6A, 0x73, 0x7D, 0x87, 0x90, 0x98, 0x9B, 0x9B, 0x97,
+    0x90, 0x87, 0x7D, 0x73, 0x6B, 0x66, 0x65, 0x67, 0x6D, 0x76, 0x80, 0x89, 0x92, 0x98, 0x9A, 0x99,
+    0x95, 0x8D, 0x84, 0x7A, 0x71, 0x6B, 0x67, 0x67, 0x6A, 0x70, 0x79, 0x82, 0x8B, 0x93, 0x98, 0x99,
+    0x97, 0x92, 0x8A, 0x81, 0x78, 0x70, 0x6A, 0x68, 0x68, 0x6C, 0x73, 0x7C, 0x85, 0x8D, 0x94, 0x97,
+    0x98, 0x95, 0x8F, 0x87, 0x7F, 0x76, 0x6F, 0x6A, 0x69, 0x6A, 0x6F, 0x76, 0x7E, 0x87, 0x8E, 0x94,
+    0x97, 0x96, 0x93, 0x8D, 0x85, 0x7C, 0x75, 0x6E, 0x6B, 0x6A, 0x6C, 0x71, 0x78, 0x81, 0x89, 0x8F,
+    0x94, 0x96, 0x94, 0x90, 0x8A, 0x82, 0x7A, 0x73, 0x6E, 0x6B, 0x6B, 0x6E, 0x74, 0x7B, 0x83, 0x8A,
+    0x90, 0x94, 0x95, 0x93, 0x8E, 0x88, 0x80, 0x79, 0x72, 0x6E, 0x6C, 0x6D, 0x70, 0x76, 0x7D, 0x85,
+    0x8B, 0x90, 0x93, 0x93, 0x91, 0x8C, 0x85, 0x7E, 0x77, 0x72, 0x6E, 0x6D, 0x6F, 0x73, 0x78, 0x7F,
+    0x86, 0x8C, 0x90, 0x92, 0x92, 0x8F, 0x8A, 0x83, 0x7C, 0x76, 0x71, 0x6F, 0x6E, 0x70, 0x75, 0x7B,
+    0x81, 0x88, 0x8D, 0x90, 0x91, 0x90, 0x8D, 0x87, 0x81, 0x7B, 0x75, 0x71, 0x6F, 0x70, 0x72, 0x77,
+    0x7D, 0x83, 0x89, 0x8D, 0x90, 0x90, 0x8F, 0x8B, 0x85, 0x7F, 0x7A, 0x75, 0x71, 0x70, 0x71, 0x74,
+    0x79, 0x7E, 0x84, 0x89, 0x8D, 0x8F, 0x8F, 0x8D, 0x89, 0x84, 0x7E, 0x79, 0x74, 0x72, 0x71, 0x72,
+    0x76, 0x7B, 0x80, 0x85, 0x8A, 0x8D, 0x8F, 0x8E, 0x8B, 0x87, 0x82, 0x7D, 0x78, 0x74, 0x72, 0x72,
+    0x74, 0x78, 0x7C, 0x81, 0x86, 0x8A, 0x8D, 0x8E, 0x8C, 0x8A, 0x85, 0x80, 0x7B, 0x77, 0x74, 0x73,
+    0x73, 0x76, 0x79, 0x7E, 0x83, 0x87, 0x8B, 0x8D, 0x8D, 0x8B, 0x88, 0x84, 0x7F, 0x7B, 0x77, 0x74,
+    0x74, 0x75, 0x77, 0x7B, 0x7F, 0x84, 0x88, 0x8B, 0x8C, 0x8C, 0x8A, 0x86, 0x82, 0x7E, 0x7A, 0x77,
+    0x75, 0x75, 0x76, 0x79, 0x7C, 0x80, 0x85, 0x88, 0x8A, 0x8B, 0x8A, 0x88, 0x85, 0x81, 0x7D, 0x79,
+    0x77, 0x75, 0x76, 0x77, 0x7A, 0x7E, 0x82, 0x85, 0x88, 0x8A, 0x8A, 0x89, 0x87, 0x84, 0x80, 0x7C,
+    0x79, 0x77, 0x76, 0x77, 0x78, 0x7B, 0x7F, 0x82, 0x86, 0x88, 0x89, 0x89, 0x88, 0x86, 0x82, 0x7F,
+    0x7C, 0x79, 0x77, 0x77, 0x78, 0x7A, 0x7C, 0x80, 0x83, 0x86, 0x88, 0x89, 0x88, 0x87, 0x84, 0x81,
+    0x7E, 0x7B, 0x79, 0x78, 0x78, 0x79, 0x7B, 0x7E, 0x81, 0x84, 0x86, 0x88, 0x88, 0x88, 0x86, 0x83,
+    0x80, 0x7D, 0x7B, 0x79, 0x78, 0x78, 0x7A, 0x7C, 0x7F, 0x81, 0x84, 0x86, 0x87, 0x87, 0x87, 0x85,
+    0x82, 0x80, 0x7D, 0x7B, 0x79, 0x79, 0x79, 0x7B, 0x7D, 0x7F, 0x82, 0x84, 0x86, 0x87, 0x87, 0x86,
+    0x84, 0x81, 0x7F, 0x7D, 0x7B, 0x7A, 0x79, 0x7A, 0x7C, 0x7E, 0x80, 0x82, 0x84, 0x86, 0x86, 0x86,
+    0x85, 0x83, 0x81, 0x7E, 0x7C, 0x7B, 0x7A, 0x7A, 0x7B, 0x7D, 0x7F, 0x81, 0x83, 0x84, 0x85, 0x86,
+    0x85, 0x84, 0x82, 0x80, 0x7E, 0x7C, 0x7B, 0x7B, 0x7B, 0x7C, 0x7D, 0x7F, 0x81, 0x83, 0x84, 0x85,
+    0x85, 0x84, 0x83, 0x81, 0x80, 0x7E, 0x7C, 0x7B, 0x7B, 0x7C, 0x7D, 0x7E, 0x80, 0x82, 0x83, 0x84,
+    0x85, 0x84, 0x84, 0x82, 0x81, 0x7F, 0x7E, 0x7C, 0x7C, 0x7C, 0x7C, 0x7D, 0x7F, 0x80, 0x82, 0x83,
+    0x84, 0x84, 0x84, 0x83, 0x82, 0x80, 0x7F, 0x7E, 0x7D, 0x7C, 0x7C, 0x7D, 0x7E, 0x7F, 0x81, 0x82,
+    0x83, 0x83, 0x84, 0x83, 0x82, 0x81, 0x80, 0x7F, 0x7E, 0x7D, 0x7D, 0x7D, 0x7D, 0x7E, 0x80, 0x81,
+    0x82, 0x83, 0x83, 0x83, 0x83, 0x82, 0x81, 0x80, 0x7F, 0x7E, 0x7D, 0x7D, 0x7D, 0x7E, 0x7F, 0x80,
+    0x81, 0x82, 0x83, 0x83, 0x83, 0x82, 0x81, 0x80, 0x7F, 0x7E, 0x7E, 0x7D, 0x7D, 0x7E, 0x7E, 0x7F,
+    0x80, 0x81, 0x82, 0x82, 0x82, 0x82, 0x82, 0x81, 0x80, 0x7F, 0x7F, 0x7E, 0x7E, 0x7E, 0x7E, 0x7F,
+    0x80, 0x80, 0x81, 0x82, 0x82, 0x82, 0x82, 0x81, 0x81, 0x80, 0x7F, 0x7F, 0x7E, 0x7E, 0x7E, 0x7F,
+    0x7F, 0x80, 0x81, 0x81, 0x82, 0x82, 0x82, 0x81, 0x81, 0x80, 0x80, 0x7F, 0x7F, 0x7F, 0x7E, 0x7F,
+    0x7F, 0x80, 0x80, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0x80, 0x80, 0x7F, 0x7F, 0x7F, 0x7F,
+    0x7F, 0x7F, 0x80, 0x80, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0x80, 0x80, 0x80, 0x7F, 0x7F, 0x7F,
+    0x7F, 0x7F, 0x80, 0x80, 0x80, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0x80, 0x80, 0x80, 0x7F, 0x7F,
+    0x7F, 0x7F, 0x7F, 0x80, 0x80, 0x80, 0x80, 0x81, 0x81, 0x81, 0x81, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x7F, 0x7F, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x81, 0x83, 0x85, 0x85,
+    0x83, 0x7E, 0x78, 0x73, 0x72, 0x76, 0x7E, 0x89, 0x92, 0x97, 0x94, 0x8A, 0x7C, 0x6D, 0x63, 0x61,
+    0x69, 0x7A, 0x8E, 0x9F, 0xA8, 0xA4, 0x95, 0x7E, 0x65, 0x54, 0x50, 0x5A, 0x72, 0x8F, 0xAA, 0xB8,
+    0xB6, 0xA2, 0x82, 0x60, 0x47, 0x3E, 0x4A, 0x67, 0x8E, 0xB2, 0xC7, 0xC7, 0xB1, 0x8A, 0x5E, 0x3C,
+    0x2E, 0x39, 0x5B, 0x89, 0xB5, 0xD1, 0xD3, 0xBC, 0x92, 0x63, 0x3D, 0x2C, 0x34, 0x54, 0x81, 0xAE,
+    0xCD, 0xD4, 0xC1, 0x9A, 0x6B, 0x43, 0x2E, 0x32, 0x4E, 0x7A, 0xA7, 0xC9, 0xD3, 0xC5, 0xA0, 0x73,
+    0x49, 0x30, 0x30, 0x49, 0x72, 0xA0, 0xC4, 0xD3, 0xC8, 0xA7, 0x7A, 0x4F, 0x33, 0x2F, 0x44, 0x6B,
+    0x99, 0xBF, 0xD1, 0xCA, 0xAD, 0x82, 0x56, 0x37, 0x2F, 0x40, 0x64, 0x91, 0xB9, 0xCF, 0xCC, 0xB2,
+    0x89, 0x5D, 0x3C, 0x30, 0x3C, 0x5E, 0x8A, 0xB3, 0xCC, 0xCE, 0xB7, 0x90, 0x64, 0x40, 0x31, 0x39,
+    0x58, 0x83, 0xAD, 0xC9, 0xCE, 0xBC, 0x97, 0x6B, 0x46, 0x32, 0x37, 0x52, 0x7C, 0xA6, 0xC5, 0xCE,
+    0xBF, 0x9D, 0x72, 0x4B, 0x35, 0x36, 0x4D, 0x75, 0x9F, 0xC0, 0xCD, 0xC3, 0xA3, 0x79, 0x51, 0x38,
+    0x35, 0x49, 0x6E, 0x99, 0xBC, 0xCC, 0xC5, 0xA9, 0x80, 0x57, 0x3B, 0x34, 0x45, 0x67, 0x92, 0xB6,
+    0xCA, 0xC7, 0xAE, 0x87, 0x5E, 0x3F, 0x35, 0x41, 0x61, 0x8B, 0xB1, 0xC8, 0xC8, 0xB3, 0x8E, 0x64,
+    0x44, 0x36, 0x3F, 0x5C, 0x84, 0xAB, 0xC5, 0xC9, 0xB7, 0x94, 0x6B, 0x48, 0x37, 0x3C, 0x56, 0x7D,
+    0xA5, 0xC1, 0xC9, 0xBB, 0x9A, 0x72, 0x4E, 0x39, 0x3B, 0x52, 0x77, 0x9F, 0xBD, 0xC8, 0xBE, 0xA0,
+    0x78, 0x53, 0x3C, 0x3A, 0x4D, 0x70, 0x98, 0xB8, 0xC7, 0xC0, 0xA5, 0x7F, 0x59, 0x3F, 0x39, 0x49,
+    0x6A, 0x92, 0xB4, 0xC6, 0xC2, 0xAA, 0x85, 0x5F, 0x43, 0x3A, 0x46, 0x64, 0x8B, 0xAE, 0xC3, 0xC3,
+    0xAF, 0x8C, 0x65, 0x47, 0x3A, 0x43, 0x5F, 0x85, 0xA9, 0xC0, 0xC4, 0xB3, 0x92, 0x6B, 0x4B, 0x3C,
+    0x41, 0x5A, 0x7F, 0xA3, 0xBD, 0xC4, 0xB6, 0x97, 0x71, 0x50, 0x3E, 0x40, 0x56, 0x78, 0x9E, 0xBA,
+    0xC4, 0xB9, 0x9D, 0x78, 0x55, 0x40, 0x3F, 0x51, 0x72, 0x98, 0xB5, 0xC3, 0xBB, 0xA2, 0x7E, 0x5B,
+    0x43, 0x3E, 0x4E, 0x6D, 0x92, 0xB1, 0xC1, 0xBD, 0xA6, 0x84, 0x60, 0x46, 0x3E, 0x4B, 0x67, 0x8C,
+    0xAC, 0xBF, 0xBE, 0xAB, 0x8A, 0x66, 0x4A, 0x3F, 0x48, 0x62, 0x86, 0xA7, 0xBD, 0xBF, 0xAE, 0x8F,
+    0x6C, 0x4E, 0x40, 0x46, 0x5E, 0x80, 0xA2, 0xBA, 0xBF, 0xB2, 0x95, 0x71, 0x53, 0x42, 0x44, 0x59,
+    0x7A, 0x9D, 0xB6, 0xBF, 0xB4, 0x9A, 0x77, 0x57, 0x44, 0x43, 0x55, 0x74, 0x97, 0xB2, 0xBE, 0xB7,
+    0x9E, 0x7D, 0x5C, 0x47, 0x43, 0x52, 0x6F, 0x91, 0xAE, 0xBD, 0xB8, 0xA3, 0x82, 0x61, 0x4A, 0x43,
+    0x4F, 0x6A, 0x8C, 0xAA, 0xBB, 0xBA, 0xA7, 0x88, 0x67, 0x4D, 0x44, 0x4D, 0x65, 0x86, 0xA5, 0xB9,
+    0xBA, 0xAA, 0x8D, 0x6C, 0x51, 0x45, 0x4B, 0x61, 0x81, 0xA0, 0xB6, 0xBB, 0xAD, 0x92, 0x71, 0x55,
+    0x46, 0x49, 0x5D, 0x7B, 0x9B, 0xB3, 0xBA, 0xB0, 0x97, 0x77, 0x5A, 0x48, 0x48, 0x59, 0x76, 0x96,
+    0xAF, 0xBA, 0xB2, 0x9B, 0x7C, 0x5E, 0x4B, 0x48, 0x56, 0x71, 0x91, 0xAC, 0xB9, 0xB4, 0x9F, 0x81,
+    0x63, 0x4D, 0x48, 0x53, 0x6D, 0x8C, 0xA8, 0xB7, 0xB5, 0xA3, 0x86, 0x68, 0x50, 0x48, 0x51, 0x68,
+    0x87, 0xA3, 0xB5, 0xB6, 0xA7, 0x8B, 0x6D, 0x54, 0x49, 0x4F, 0x64, 0x82, 0x9F, 0xB2, 0xB6, 0xAA,
+    0x90, 0x72, 0x58, 0x4A, 0x4D, 0x60, 0x7D, 0x9A, 0xAF, 0xB6, 0xAC, 0x94, 0x77, 0x5C, 0x4C, 0x4D,
+    0x5D, 0x78, 0x95, 0xAC, 0xB5, 0xAE, 0x99, 0x7B, 0x60, 0x4E, 0x4C, 0x5A, 0x73, 0x91, 0xA9, 0xB4,
+    0xB0, 0x9C, 0x80, 0x64, 0x51, 0x4C, 0x57, 0x6F, 0x8C, 0xA5, 0xB3, 0xB1, 0xA0, 0x85, 0x69, 0x54,
+    0x4C, 0x55, 0x6B, 0x87, 0xA1, 0xB1, 0xB2, 0xA3, 0x8A, 0x6D, 0x57, 0x4D, 0x53, 0x67, 0x82, 0x9D,
+    0xAF, 0xB2, 0xA6, 0x8E, 0x72, 0x5A, 0x4E, 0x52, 0x63, 0x7E, 0x99, 0xAC, 0xB2, 0xA8, 0x92, 0x76,
+    0x5E, 0x50, 0x51, 0x60, 0x79, 0x95, 0xA9, 0xB1, 0xAA, 0x96, 0x7B, 0x62, 0x52, 0x50, 0x5D, 0x75,
+    0x90, 0xA6, 0xB0, 0xAC, 0x99, 0x7F, 0x66, 0x54, 0x50, 0x5B, 0x71, 0x8C, 0xA3, 0xAF, 0xAD, 0x9D,
+    0x84, 0x6A, 0x57, 0x50, 0x59, 0x6D, 0x87, 0x9F, 0xAD, 0xAE, 0xA0, 0x88, 0x6E, 0x5A, 0x51, 0x57,
+    0x6A, 0x83, 0x9C, 0xAB, 0xAE, 0xA2, 0x8C, 0x72, 0x5D, 0x52, 0x56, 0x66, 0x7F, 0x98, 0xA9, 0xAE,
+    0xA4, 0x90, 0x76, 0x60, 0x54, 0x55, 0x63, 0x7B, 0x94, 0xA6, 0xAD, 0xA6, 0x93, 0x7B, 0x63, 0x55,
+    0x54, 0x61, 0x77, 0x90, 0xA4, 0xAD, 0xA8, 0x97, 0x7F, 0x67, 0x57, 0x54, 0x5E, 0x73, 0x8C, 0xA1,
+    0xAB, 0xA9, 0x9A, 0x83, 0x6B, 0x5A, 0x54, 0x5C, 0x6F, 0x88, 0x9D, 0xAA, 0xAA, 0x9C, 0x87, 0x6F,
+    0x5C, 0x55, 0x5B, 0x6C, 0x84, 0x9A, 0xA8, 0xAA, 0x9F, 0x8A, 0x73, 0x5F, 0x56, 0x5A, 0x69, 0x80,
+    0x96, 0xA6, 0xAA, 0xA1, 0x8E, 0x76, 0x62, 0x57, 0x59, 0x66, 0x7C, 0x93, 0xA4, 0xAA, 0xA3, 0x91,
+    0x7A, 0x65, 0x59, 0x58, 0x64, 0x78, 0x8F, 0xA1, 0xA9, 0xA4, 0x94, 0x7E, 0x69, 0x5A, 0x58, 0x62,
+    0x75, 0x8B, 0x9E, 0xA8, 0xA5, 0x97, 0x82, 0x6C, 0x5D, 0x58, 0x60, 0x72, 0x88, 0x9B, 0xA7, 0xA6,
+    0x9A, 0x85, 0x70, 0x5F, 0x59, 0x5E, 0x6E, 0x84, 0x98, 0xA5, 0xA6, 0x9C, 0x89, 0x73, 0x62, 0x59,
+    0x5D, 0x6C, 0x80, 0x95, 0xA3, 0xA6, 0x9E, 0x8C, 0x77, 0x64, 0x5A, 0x5C, 0x69, 0x7D, 0x92, 0xA1,
+    0xA6, 0x9F, 0x8F, 0x7A, 0x67, 0x5C, 0x5C, 0x67, 0x7A, 0x8E, 0x9F, 0xA5, 0xA1, 0x92, 0x7E, 0x6A,
+    0x5E, 0x5C, 0x65, 0x76, 0x8B, 0x9C, 0xA4, 0xA2, 0x94, 0x81, 0x6D, 0x5F, 0x5C, 0x63, 0x73, 0x88,
+    0x99, 0xA3, 0xA2, 0x97, 0x84, 0x70, 0x62, 0x5C, 0x62, 0x71, 0x84, 0x96, 0xA2, 0xA3, 0x99, 0x87,
+    0x74, 0x64, 0x5D, 0x61, 0x6E, 0x81, 0x94, 0xA0, 0xA3, 0x9B, 0x8A, 0x77, 0x66, 0x5E, 0x60, 0x6C,
+    0x7E, 0x91, 0x9E, 0xA2, 0x9C, 0x8D, 0x7A, 0x69, 0x5F, 0x5F, 0x6A, 0x7B, 0x8E, 0x9C, 0xA2, 0x9D,
+    0x90, 0x7D, 0x6C, 0x61, 0x5F, 0x68, 0x78, 0x8A, 0x9A, 0xA1, 0x9E, 0x92, 0x80, 0x6F, 0x62, 0x5F,
+    0x66, 0x75, 0x87, 0x97, 0xA0, 0x9F, 0x94, 0x83, 0x71, 0x64, 0x5F, 0x65, 0x73, 0x84, 0x95, 0x9F,
+    0x9F, 0x96, 0x86, 0x74, 0x66, 0x60, 0x64, 0x70, 0x81, 0x92, 0x9D, 0x9F, 0x98, 0x89, 0x77, 0x68,
+    0x61, 0x63, 0x6E, 0x7F, 0x8F, 0x9C, 0x9F, 0x99, 0x8B, 0x7A, 0x6B, 0x62, 0x63, 0x6C, 0x7C, 0x8D,
+    0x9A, 0x9F, 0x9A, 0x8E, 0x7D, 0x6D, 0x63, 0x62, 0x6A, 0x79, 0x8A, 0x98, 0x9E, 0x9B, 0x90, 0x80,
+    0x70, 0x65, 0x62, 0x69, 0x77, 0x87, 0x95, 0x9D, 0x9C, 0x92, 0x82, 0x72, 0x67, 0x63, 0x68, 0x74,
+    0x84, 0x93, 0x9C, 0x9C, 0x93, 0x85, 0x75, 0x68, 0x63, 0x67, 0x72, 0x82, 0x91, 0x9B, 0x9C, 0x95,
+    0x87, 0x78, 0x6A, 0x64, 0x66, 0x70, 0x7F, 0x8E, 0x99, 0x9C, 0x96, 0x8A, 0x7A, 0x6D, 0x65, 0x66,
+    0x6F, 0x7D, 0x8C, 0x97, 0x9C, 0x97, 0x8C, 0x7D, 0x6F, 0x66, 0x65, 0x6D, 0x7A, 0x89, 0x95, 0x9B,
+    0x98, 0x8E, 0x7F, 0x71, 0x67, 0x65, 0x6C, 0x78, 0x87, 0x94, 0x9A, 0x99, 0x90, 0x82, 0x73, 0x69,
+    0x66, 0x6B, 0x76, 0x84, 0x91, 0x99, 0x99, 0x91, 0x84, 0x76, 0x6B, 0x66, 0x6A, 0x74, 0x82, 0x8F,
+    0x98, 0x99, 0x92, 0x86, 0x78, 0x6C, 0x67, 0x69, 0x72, 0x80, 0x8D, 0x97, 0x99, 0x94, 0x88, 0x7A,
+    0x6E, 0x68, 0x69, 0x71, 0x7D, 0x8B, 0x95, 0x99, 0x95, 0x8A, 0x7D, 0x70, 0x69, 0x68, 0x6F, 0x7B,
+    0x89, 0x93, 0x98, 0x95, 0x8C, 0x7F, 0x72, 0x6A, 0x68, 0x6E, 0x79, 0x87, 0x92, 0x97, 0x96, 0x8E,
+    0x81, 0x74, 0x6B, 0x69, 0x6D, 0x77, 0x84, 0x90, 0x96, 0x96, 0x8F, 0x83, 0x77, 0x6D, 0x69, 0x6C,
+    0x76, 0x82, 0x8E, 0x95, 0x96, 0x90, 0x85, 0x79, 0x6E, 0x6A, 0x6C, 0x74, 0x80, 0x8C, 0x94, 0x96,
+    0x91, 0x87, 0x7B, 0x70, 0x6A, 0x6B, 0x73, 0x7E, 0x8A, 0x93, 0x96, 0x92, 0x89, 0x7D, 0x72, 0x6B,
+    0x6B, 0x71, 0x7C, 0x88, 0x91, 0x95, 0x93, 0x8A, 0x7F, 0x74, 0x6C, 0x6B, 0x70, 0x7A, 0x86, 0x90,
+    0x95, 0x93, 0x8C, 0x81, 0x75, 0x6E, 0x6B, 0x70, 0x79, 0x84, 0x8E, 0x94, 0x93, 0x8D, 0x82, 0x77,
+    0x6F, 0x6C, 0x6F, 0x77, 0x82, 0x8D, 0x93, 0x94, 0x8E, 0x84, 0x79, 0x70, 0x6C, 0x6E, 0x76, 0x80,
+    0x8B, 0x92, 0x93, 0x8F, 0x86, 0x7B, 0x72, 0x6D, 0x6E, 0x75, 0x7F, 0x89, 0x91, 0x93, 0x90, 0x87,
+    0x7D, 0x73, 0x6E, 0x6E, 0x73, 0x7D, 0x87, 0x90, 0x93, 0x90, 0x89, 0x7F, 0x75, 0x6F, 0x6E, 0x73,
+    0x7B, 0x86, 0x8E, 0x92, 0x91, 0x8A, 0x80, 0x76, 0x70, 0x6E, 0x72, 0x7A, 0x84, 0x8D, 0x92, 0x91,
+    0x8B, 0x82, 0x78, 0x71, 0x6E, 0x71, 0x79, 0x82, 0x8B, 0x91, 0x91, 0x8C, 0x83, 0x7A, 0x72, 0x6F,
+    0x71, 0x77, 0x81, 0x8A, 0x90, 0x91, 0x8D, 0x85, 0x7B, 0x73, 0x6F, 0x70, 0x76, 0x7F, 0x88, 0x8F,
+    0x91, 0x8E, 0x86, 0x7D, 0x75, 0x70, 0x70, 0x75, 0x7E, 0x87, 0x8E, 0x90, 0x8E, 0x87, 0x7E, 0x76,
+    0x71, 0x70, 0x74, 0x7C, 0x85, 0x8D, 0x90, 0x8E, 0x88, 0x80, 0x77, 0x72, 0x70, 0x74, 0x7B, 0x84,
+    0x8B, 0x8F, 0x8F, 0x89, 0x81, 0x79, 0x73, 0x71, 0x73, 0x7A, 0x82, 0x8A, 0x8F, 0x8F, 0x8A, 0x83,
+    0x7A, 0x74, 0x71, 0x73, 0x79, 0x81, 0x89, 0x8E, 0x8F, 0x8B, 0x84, 0x7C, 0x75, 0x71, 0x73, 0x78,
+    0x80, 0x87, 0x8D, 0x8E, 0x8C, 0x85, 0x7D, 0x76, 0x72, 0x72, 0x77, 0x7E, 0x86, 0x8C, 0x8E, 0x8C,
+    0x86, 0x7E, 0x77, 0x73, 0x72, 0x76, 0x7D, 0x85, 0x8B, 0x8E, 0x8C, 0x87, 0x80, 0x78, 0x74, 0x73,
+    0x76, 0x7C, 0x83, 0x8A, 0x8D, 0x8C, 0x88, 0x81, 0x7A, 0x74, 0x73, 0x75, 0x7B, 0x82, 0x89, 0x8D,
+    0x8D, 0x89, 0x82, 0x7B, 0x75, 0x73, 0x75, 0x7A, 0x81, 0x88, 0x8C, 0x8C, 0x89, 0x83, 0x7C, 0x76,
+    0x74, 0x75, 0x79, 0x80, 0x86, 0x8B, 0x8C, 0x8A, 0x84, 0x7D, 0x77, 0x74, 0x74, 0x78, 0x7F, 0x85,
+    0x8A, 0x8C, 0x8A, 0x85, 0x7E, 0x78, 0x75, 0x74, 0x78, 0x7E, 0x84, 0x89, 0x8C, 0x8A, 0x86, 0x80,
+    0x79, 0x75, 0x75, 0x77, 0x7D, 0x83, 0x89, 0x8B, 0x8B, 0x87, 0x81, 0x7A, 0x76, 0x75, 0x77, 0x7C,
+    0x82, 0x88, 0x8B, 0x8B, 0x87, 0x82, 0x7C, 0x77, 0x75, 0x77, 0x7B, 0x81, 0x87, 0x8A, 0x8B, 0x88,
+    0x82, 0x7D, 0x78, 0x75, 0x76, 0x7A, 0x80, 0x86, 0x89, 0x8A, 0x88, 0x83, 0x7E, 0x79, 0x76, 0x76,
+    0x7A, 0x7F, 0x85, 0x89, 0x8A, 0x88, 0x84, 0x7F, 0x79, 0x76, 0x76, 0x79, 0x7E, 0x84, 0x88, 0x8A,
+    0x89, 0x85, 0x7F, 0x7A, 0x77, 0x76, 0x79, 0x7D, 0x83, 0x87, 0x89, 0x89, 0x85, 0x80, 0x7B, 0x78,
+    0x77, 0x79, 0x7D, 0x82, 0x86, 0x89, 0x89, 0x86, 0x81, 0x7C, 0x78, 0x77, 0x78, 0x7C, 0x81, 0x86,
+    0x88, 0x89, 0x86, 0x82, 0x7D, 0x79, 0x77, 0x78, 0x7B, 0x80, 0x85, 0x88, 0x89, 0x87, 0x83, 0x7E,
+    0x7A, 0x78, 0x78, 0x7B, 0x7F, 0x84, 0x87, 0x88, 0x87, 0x83, 0x7F, 0x7A, 0x78, 0x78, 0x7B, 0x7F,
+    0x83, 0x87, 0x88, 0x87, 0x84, 0x7F, 0x7B, 0x79, 0x78, 0x7A, 0x7E, 0x82, 0x86, 0x88, 0x87, 0x84,
+    0x80, 0x7C, 0x79, 0x78, 0x7A, 0x7D, 0x82, 0x85, 0x87, 0x87, 0x85, 0x81, 0x7D, 0x7A, 0x79, 0x7A,
+    0x7D, 0x81, 0x85, 0x87, 0x87, 0x85, 0x81, 0x7D, 0x7A, 0x79, 0x7A, 0x7C, 0x80, 0x84, 0x86, 0x87,
+    0x85, 0x82, 0x7E, 0x7B, 0x79, 0x7A, 0x7C, 0x80, 0x83, 0x86, 0x87, 0x85, 0x83, 0x7F, 0x7B, 0x7A,
+    0x7A, 0x7C, 0x7F, 0x83, 0x85, 0x87, 0x86, 0x83, 0x7F, 0x7C, 0x7A, 0x7A, 0x7B, 0x7F, 0x82, 0x85,
+    0x86, 0x86, 0x83, 0x80, 0x7D, 0x7A, 0x7A, 0x7B, 0x7E, 0x81, 0x84, 0x86, 0x86, 0x84, 0x81, 0x7D,
+    0x7B, 0x7A, 0x7B, 0x7E, 0x81, 0x84, 0x86, 0x86, 0x84, 0x81, 0x7E, 0x7B, 0x7A, 0x7B, 0x7D, 0x80,
+    0x83, 0x85, 0x86, 0x84, 0x81, 0x7E, 0x7C, 0x7B, 0x7B, 0x7D, 0x80, 0x83, 0x85, 0x85, 0x84, 0x82,
+    0x7F, 0x7C, 0x7B, 0x7B, 0x7D, 0x7F, 0x82, 0x84, 0x85, 0x84, 0x82, 0x7F, 0x7D, 0x7B, 0x7B, 0x7C,
+    0x7F, 0x82, 0x84, 0x85, 0x84, 0x83, 0x80, 0x7D, 0x7C, 0x7B, 0x7C, 0x7F, 0x81, 0x83, 0x85, 0x84,
+    0x83, 0x80, 0x7E, 0x7C, 0x7B, 0x7C, 0x7E, 0x81, 0x83, 0x84, 0x84, 0x83, 0x81, 0x7E, 0x7C, 0x7C,
+    0x7C, 0x7E, 0x80, 0x83, 0x84, 0x84, 0x83, 0x81, 0x7F, 0x7D, 0x7C, 0x7C, 0x7E, 0x80, 0x82, 0x84,
+    0x84, 0x83, 0x81, 0x7F, 0x7D, 0x7C, 0x7C, 0x7E, 0x80, 0x82, 0x83, 0x84, 0x83, 0x82, 0x80, 0x7E,
+    0x7C, 0x7C, 0x7D, 0x7F, 0x81, 0x83, 0x84, 0x83, 0x82, 0x80, 0x7E, 0x7D, 0x7C, 0x7D, 0x7F, 0x81,
+    0x83, 0x84, 0x83, 0x82, 0x80, 0x7E, 0x7D, 0x7D, 0x7D, 0x7F, 0x81, 0x82, 0x83, 0x83, 0x82, 0x80,
+    0x7F, 0x7D, 0x7D, 0x7D, 0x7F, 0x80, 0x82, 0x83, 0x83, 0x82, 0x81, 0x7F, 0x7E, 0x7D, 0x7D, 0x7E,
+    0x80, 0x82, 0x83, 0x83, 0x82, 0x81, 0x7F, 0x7E, 0x7D, 0x7D, 0x7E, 0x80, 0x81, 0x82, 0x83, 0x82,
+    0x81, 0x80, 0x7E, 0x7D, 0x7D, 0x7E, 0x7F, 0x81, 0x82, 0x83, 0x82, 0x81, 0x80, 0x7E, 0x7E, 0x7D,
+    0x7E, 0x7F, 0x81, 0x82, 0x83, 0x82, 0x81, 0x80, 0x7F, 0x7E, 0x7E, 0x7E, 0x7F, 0x80, 0x82, 0x82,
+    0x82, 0x82, 0x80, 0x7F, 0x7E, 0x7E, 0x7E, 0x7F, 0x80, 0x81, 0x82, 0x82, 0x82, 0x80, 0x7F, 0x7E,
+    0x7E, 0x7E, 0x7F, 0x80, 0x81, 0x82, 0x82, 0x82, 0x81, 0x7F, 0x7E, 0x7E, 0x7E, 0x7F, 0x80, 0x81,
+    0x82, 0x82, 0x82, 0x81, 0x80, 0x7F, 0x7E, 0x7E, 0x7F, 0x80, 0x81, 0x82, 0x82, 0x82, 0x81, 0x80,
+    0x7F, 0x7E, 0x7E, 0x7F, 0x80, 0x81, 0x81, 0x82, 0x82, 0x81, 0x80, 0x7F, 0x7F, 0x7E, 0x7F, 0x7F,
+    0x80, 0x81, 0x82, 0x82, 0x81, 0x80, 0x7F, 0x7F, 0x7E, 0x7F, 0x7F, 0x80, 0x81, 0x81, 0x81, 0x81,
+    0x80, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x80, 0x81, 0x81, 0x81, 0x81, 0x80, 0x80, 0x7F, 0x7F, 0x7F,
+    0x7F, 0x80, 0x81, 0x81, 0x81, 0x81, 0x80, 0x80, 0x7F, 0x7F, 0x7F, 0x7F, 0x80, 0x80, 0x81, 0x81,
+    0x81, 0x81, 0x80, 0x7F, 0x7F, 0x7F, 0x7F, 0x80, 0x80, 0x81, 0x81, 0x81, 0x81, 0x80, 0x7F, 0x7F,
+    0x7F, 0x7F, 0x80, 0x80, 0x81, 0x81, 0x81, 0x81, 0x80, 0x80, 0x7F, 0x7F, 0x7F, 0x80, 0x80, 0x81,
+    0x81, 0x81, 0x81, 0x80, 0x80, 0x7F, 0x7F, 0x7F, 0x80, 0x80, 0x80, 0x81, 0x81, 0x81, 0x80, 0x80,
+    0x7F, 0x7F, 0x7F, 0x80, 0x80, 0x80, 0x81, 0x81, 0x81, 0x80, 0x80, 0x80, 0x7F, 0x7F, 0x80, 0x80,
+    0x80, 0x81, 0x81, 0x81, 0x80, 0x80, 0x80, 0x7F, 0x7F, 0x80, 0x80, 0x80, 0x80, 0x81, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+};
+
+// beep.wav: 8-bit, 11025 Hz, 882 samples
+static const BYTE clip1Data[882] = {
+    0x80, 0x81, 0x83, 0x81, 0x7B, 0x78, 0x7D, 0x88, 0x8D, 0x86, 0x77, 0x6E, 0x76, 0x89, 0x96, 0x8F,
+    0x78, 0x66, 0x6C, 0x86, 0x9D, 0x9A, 0x7D, 0x61, 0x60, 0x7E, 0xA0, 0xA6, 0x88, 0x60, 0x54, 0x71,
+    0x9F, 0xB2, 0x97, 0x65, 0x4A, 0x61, 0x97, 0xB9, 0xA7, 0x6F, 0x44, 0x50, 0x8A, 0xBD, 0xB8, 0x7F,
+    0x44, 0x40, 0x78, 0xB9, 0xC7, 0x93, 0x4B, 0x32, 0x63, 0xAE, 0xCE, 0xA6, 0x5B, 0x32, 0x51, 0x9B,
+    0xCC, 0xB6, 0x6F, 0x38, 0x44, 0x87, 0xC4, 0xC2, 0x83, 0x42, 0x3A, 0x73, 0xB8, 0xC8, 0x96, 0x50,
+    0x36, 0x61, 0xA8, 0xCA, 0xA8, 0x61, 0x37, 0x51, 0x96, 0xC6, 0xB6, 0x74, 0x3D, 0x45, 0x83, 0xBE,
+    0xC0, 0x87, 0x48, 0x3D, 0x70, 0xB1, 0xC5, 0x99, 0x56, 0x3A, 0x5F, 0xA2, 0xC5, 0xA8, 0x67, 0x3C,
+    0x51, 0x91, 0xC1, 0xB5, 0x78, 0x43, 0x46, 0x7F, 0xB8, 0xBD, 0x8A, 0x4E, 0x40, 0x6D, 0xAC, 0xC1,
+    0x9B, 0x5C, 0x3F, 0x5E, 0x9C, 0xC0, 0xA9, 0x6C, 0x42, 0x51, 0x8C, 0xBB, 0xB4, 0x7C, 0x49, 0x48,
+    0x7B, 0xB2, 0xBB, 0x8D, 0x54, 0x43, 0x6B, 0xA6, 0xBD, 0x9C, 0x61, 0x43, 0x5D, 0x97, 0xBC, 0xA9,
+    0x70, 0x47, 0x52, 0x88, 0xB6, 0xB2, 0x80, 0x4E, 0x4A, 0x78, 0xAD, 0xB8, 0x8F, 0x59, 0x47, 0x6A,
+    0xA1, 0xB9, 0x9D, 0x66, 0x47, 0x5D, 0x93, 0xB7, 0xA8, 0x74, 0x4C, 0x53, 0x84, 0xB1, 0xB0, 0x83,
+    0x53, 0x4D, 0x76, 0xA8, 0xB5, 0x91, 0x5E, 0x4A, 0x68, 0x9C, 0xB5, 0x9E, 0x6B, 0x4C, 0x5D, 0x8F,
+    0xB2, 0xA7, 0x78, 0x50, 0x55, 0x81, 0xAC, 0xAE, 0x86, 0x58, 0x50, 0x74, 0xA3, 0xB2, 0x93, 0x63,
+    0x4E, 0x67, 0x97, 0xB1, 0x9E, 0x6F, 0x50, 0x5E, 0x8B, 0xAE, 0xA6, 0x7C, 0x55, 0x56, 0x7E, 0xA7,
+    0xAC, 0x88, 0x5D, 0x52, 0x72, 0x9E, 0xAE, 0x94, 0x67, 0x52, 0x67, 0x93, 0xAE, 0x9E, 0x72, 0x54,
+    0x5E, 0x88, 0xA9, 0xA5, 0x7E, 0x5A, 0x58, 0x7C, 0xA3, 0xAA, 0x8A, 0x61, 0x55, 0x71, 0x9A, 0xAB,
+    0x94, 0x6B, 0x55, 0x67, 0x90, 0xAA, 0x9D, 0x76, 0x58, 0x5F, 0x85, 0xA5, 0xA3, 0x81, 0x5E, 0x5B,
+    0x7A, 0x9F, 0xA7, 0x8B, 0x66, 0x58, 0x70, 0x96, 0xA8, 0x95, 0x6F, 0x59, 0x67, 0x8C, 0xA6, 0x9C,
+    0x79, 0x5C, 0x61, 0x82, 0xA1, 0xA2, 0x83, 0x62, 0x5D, 0x78, 0x9B, 0xA4, 0x8C, 0x69, 0x5B, 0x6F,
+    0x92, 0xA4, 0x95, 0x72, 0x5D, 0x68, 0x89, 0xA2, 0x9B, 0x7B, 0x60, 0x62, 0x80, 0x9D, 0xA0, 0x85,
+    0x66, 0x5F, 0x77, 0x97, 0xA2, 0x8D, 0x6D, 0x5E, 0x6F, 0x8F, 0xA1, 0x94, 0x75, 0x60, 0x69, 0x87,
+    0x9E, 0x9A, 0x7E, 0x64, 0x64, 0x7E, 0x9A, 0x9D, 0x86, 0x69, 0x62, 0x76, 0x93, 0x9F, 0x8E, 0x70,
+    0x61, 0x6F, 0x8C, 0x9E, 0x94, 0x78, 0x63, 0x6A, 0x84, 0x9B, 0x99, 0x80, 0x67, 0x66, 0x7D, 0x96,
+    0x9B, 0x87, 0x6D, 0x64, 0x75, 0x90, 0x9C, 0x8E, 0x73, 0x64, 0x6F, 0x8A, 0x9B, 0x93, 0x7A, 0x67,
+    0x6B, 0x82, 0x98, 0x97, 0x81, 0x6A, 0x68, 0x7B, 0x93, 0x99, 0x88, 0x70, 0x67, 0x75, 0x8E, 0x99,
+    0x8E, 0x76, 0x67, 0x70, 0x87, 0x98, 0x92, 0x7C, 0x6A, 0x6C, 0x81, 0x95, 0x95, 0x82, 0x6D, 0x6A,
+    0x7B, 0x90, 0x97, 0x88, 0x72, 0x69, 0x75, 0x8B, 0x97, 0x8D, 0x78, 0x6A, 0x71, 0x85, 0x95, 0x91,
+    0x7E, 0x6D, 0x6E, 0x80, 0x92, 0x94, 0x83, 0x70, 0x6C, 0x7A, 0x8E, 0x94, 0x88, 0x75, 0x6C, 0x75,
+    0x89, 0x94, 0x8D, 0x7A, 0x6D, 0x72, 0x84, 0x92, 0x90, 0x7F, 0x6F, 0x6F, 0x7E, 0x8F, 0x92, 0x84,
+    0x73, 0x6E, 0x7A, 0x8B, 0x92, 0x88, 0x77, 0x6E, 0x76, 0x87, 0x92, 0x8C, 0x7B, 0x6F, 0x73, 0x82,
+    0x90, 0x8E, 0x80, 0x72, 0x71, 0x7E, 0x8D, 0x90, 0x84, 0x75, 0x70, 0x7A, 0x89, 0x90, 0x88, 0x79,
+    0x70, 0x76, 0x85, 0x8F, 0x8B, 0x7D, 0x72, 0x74, 0x81, 0x8D, 0x8D, 0x81, 0x74, 0x72, 0x7D, 0x8B,
+    0x8E, 0x85, 0x77, 0x72, 0x7A, 0x87, 0x8E, 0x88, 0x7A, 0x72, 0x77, 0x84, 0x8D, 0x8A, 0x7E, 0x74,
+    0x75, 0x80, 0x8B, 0x8C, 0x82, 0x76, 0x74, 0x7D, 0x89, 0x8C, 0x85, 0x79, 0x74, 0x7A, 0x86, 0x8C,
+    0x87, 0x7C, 0x74, 0x78, 0x83, 0x8B, 0x89, 0x7F, 0x76, 0x76, 0x80, 0x89, 0x8A, 0x82, 0x78, 0x75,
+    0x7D, 0x87, 0x8B, 0x85, 0x7A, 0x76, 0x7A, 0x84, 0x8A, 0x87, 0x7D, 0x76, 0x79, 0x82, 0x89, 0x88,
+    0x80, 0x78, 0x77, 0x7F, 0x87, 0x89, 0x82, 0x7A, 0x77, 0x7D, 0x85, 0x89, 0x84, 0x7C, 0x77, 0x7B,
+    0x83, 0x88, 0x86, 0x7E, 0x78, 0x79, 0x81, 0x87, 0x87, 0x80, 0x79, 0x79, 0x7F, 0x86, 0x88, 0x82,
+    0x7B, 0x78, 0x7D, 0x84, 0x87, 0x84, 0x7D, 0x79, 0x7B, 0x82, 0x87, 0x85, 0x7F, 0x7A, 0x7A, 0x80,
+    0x86, 0x86, 0x81, 0x7B, 0x7A, 0x7F, 0x85, 0x86, 0x82, 0x7C, 0x7A, 0x7D, 0x83, 0x86, 0x83, 0x7E,
+    0x7A, 0x7C, 0x81, 0x85, 0x84, 0x7F, 0x7B, 0x7B, 0x80, 0x85, 0x85, 0x81, 0x7C, 0x7B, 0x7F, 0x83,
+    0x85, 0x82, 0x7D, 0x7B, 0x7D, 0x82, 0x85, 0x83, 0x7E, 0x7B, 0x7D, 0x81, 0x84, 0x84, 0x80, 0x7C,
+    0x7C, 0x80, 0x83, 0x84, 0x81, 0x7D, 0x7C, 0x7F, 0x83, 0x84, 0x82, 0x7E, 0x7C, 0x7E, 0x81, 0x84,
+    0x82, 0x7F, 0x7D, 0x7D, 0x81, 0x83, 0x83, 0x80, 0x7D, 0x7D, 0x80, 0x82, 0x83, 0x81, 0x7E, 0x7D,
+    0x7F, 0x82, 0x83, 0x81, 0x7F, 0x7D, 0x7E, 0x81, 0x83, 0x82, 0x7F, 0x7E, 0x7E, 0x80, 0x82, 0x82,
+    0x80, 0x7E, 0x7E, 0x80, 0x82, 0x82, 0x81, 0x7F, 0x7E, 0x7F, 0x81, 0x82, 0x81, 0x7F, 0x7E, 0x7F,
+    0x81, 0x82, 0x81, 0x80, 0x7E, 0x7F, 0x80, 0x82, 0x82, 0x80, 0x7F, 0x7E, 0x80, 0x81, 0x82, 0x81,
+    0x7F, 0x7F, 0x7F, 0x81, 0x81, 0x81, 0x80, 0x7F, 0x7F, 0x80, 0x81, 0x81, 0x80, 0x7F, 0x7F, 0x80,
+    0x81, 0x81, 0x80, 0x7F, 0x7F, 0x80, 0x81, 0x81, 0x80, 0x7F, 0x7F, 0x80, 0x80, 0x81, 0x81, 0x80,
+    0x7F, 0x7F, 0x80, 0x81, 0x81, 0x80, 0x7F, 0x7F, 0x80, 0x80, 0x81, 0x80, 0x80, 0x7F, 0x80, 0x80,
+    0x81, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80,
+};
+
+const WAVCLIP wavClips[clipCount] = {
+    {"chime.wav", clip0Data, 3528UL, 11025, 8},
+    {"beep.wav", clip1Data, 882UL, 11025, 8},
+};
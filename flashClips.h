@@ -0,0 +1,15 @@
+/*
+ * File:   flashClips.h
+ *
+ * Generated by flashClips.py chime.wav beep.wav, do not edit.
+ * Ids of the clips in wavClips, see wavFlashPlay.
+ */
+
+#ifndef FLASHCLIPS_H
+#define	FLASHCLIPS_H
+
+#define clipChime 0
+#define clipBeep 1
+#define clipCount 2
+
+#endif	/* FLASHCLIPS_H */
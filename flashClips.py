@@ -0,0 +1,93 @@
+#!/usr/bin/env python3
+#
+# File:   flashClips.py
+#
+# Builds the clips played from program flash (see wavFlashPlay in
+# waveReader.c) out of WAV files.  Each file must be mono 8 or 16-bit PCM.
+# Its samples are copied as they are in the data chunk into a const array,
+# which XC8 keeps in program memory, and described in the wavClips
+# directory.  Writes flashClips.c and flashClips.h in the current
+# directory.  Clip ids are named after the files: chime.wav is clipChime.
+#
+# Usage: python flashClips.py chime.wav beep.wav ...
+#
+# Sox makes suitable files, e.g. a short 11 kHz 8-bit one:
+#   sox <infile> -b 8 chime.wav channels 1 rate 11025
+#
+
+import os
+import re
+import sys
+import wave
+
+INSTR_FREQ = 8000000                    # instrFreq in waveReader.h
+MAX_RATE = 48000                        # maxSampleRate
+MIN_RATE = INSTR_FREQ // 16 // 256 + 1  # minSampleRate
+
+
+def clip_id(path):
+    words = re.findall(r"[A-Za-z0-9]+", os.path.splitext(os.path.basename(path))[0])
+    if not words:
+        sys.exit("%s: no letters or digits to name the clip after" % path)
+    return "clip" + "".join(w[0].upper() + w[1:] for w in words)
+
+
+def read_clip(path):
+    try:
+        w = wave.open(path, "rb")
+    except (wave.Error, EOFError) as e:
+        sys.exit("%s: %s" % (path, e))
+    with w:
+        if w.getnchannels() != 1:
+            sys.exit("%s: clips must be mono" % path)
+        if w.getsampwidth() not in (1, 2):
+            sys.exit("%s: clips must be 8 or 16-bit" % path)
+        if not MIN_RATE <= w.getframerate() <= MAX_RATE:
+            sys.exit("%s: sample rate must be %u to %u Hz" % (path, MIN_RATE, MAX_RATE))
+        return w.getsampwidth() * 8, w.getframerate(), w.getnframes(), w.readframes(w.getnframes())
+
+
+def main(paths):
+    if not paths:
+        sys.exit("usage: flashClips.py file.wav ...")
+    clips = []
+    for path in paths:
+        ident = clip_id(path)
+        if any(c[0] == ident for c in clips):
+            sys.exit("%s: %s is taken already" % (path, ident))
+        clips.append((ident, os.path.basename(path)) + read_clip(path))
+
+    cmd = " ".join(["flashClips.py"] + [os.path.basename(p) for p in paths])
+    with open("flashClips.h", "w") as h:
+        h.write("/*\n * File:   flashClips.h\n *\n"
+                " * Generated by %s, do not edit.\n"
+                " * Ids of the clips in wavClips, see wavFlashPlay.\n */\n\n"
+                "#ifndef FLASHCLIPS_H\n#define\tFLASHCLIPS_H\n\n" % cmd)
+        for i, c in enumerate(clips):
+            h.write("#define %s %u\n" % (c[0], i))
+        h.write("#define clipCount %u\n\n#endif\t/* FLASHCLIPS_H */\n" % len(clips))
+
+    total = 0
+    with open("flashClips.c", "w") as f:
+        f.write("/*\n * File:   flashClips.c\n *\n"
+                " * Generated by %s, do not edit.\n"
+                " * Samples of the clips played from program flash, as in the data\n"
+                " * chunk of each file.\n */\n\n"
+                "#include <xc.h>\n#include \"waveReader.h\"\n#include \"flashClips.h\"\n" % cmd)
+        for i, (ident, name, bits, rate, samples, data) in enumerate(clips):
+            f.write("\n// %s: %u-bit, %u Hz, %u samples\n" % (name, bits, rate, samples))
+            f.write("static const BYTE clip%uData[%u] = {\n" % (i, len(data)))
+            for ofs in range(0, len(data), 16):
+                f.write("    " + ", ".join("0x%02X" % b for b in data[ofs:ofs + 16]) + ",\n")
+            f.write("};\n")
+            total += len(data)
+        f.write("\nconst WAVCLIP wavClips[clipCount] = {\n")
+        for i, (ident, name, bits, rate, samples, data) in enumerate(clips):
+            f.write("    {\"%s\", clip%uData, %uUL, %u, %u},\n" % (name, i, samples, rate, bits))
+        f.write("};\n")
+
+    print("%u clips, %u bytes of samples" % (len(clips), total))
+
+
+if __name__ == "__main__":
+    main(sys.argv[1:])
@@ -0,0 +1,122 @@
+/*
+ * File:   bench_fs.c (host build)
+ *
+ * Times Petit FatFs on a card image: mount, a scan of the root
+ * directory, opening files by name, sequential reads of a contiguous and
+ * a fragmented file, and seeks about the fragmented one with and without
+ * a cluster link map.  Each is given in wall clock time on the PC, in
+ * card commands and in the bytes the SPI driver would have clocked, the
+ * last two being what costs time on the card.
+ *
+ * Usage: bench_fs card.img [latency_us]
+ *   The image needs BIG.BIN (contiguous) and FRAG.BIN (fragmented), see
+ *   host/Makefile.  The latency is added to every card command.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "../pff.h"
+#include "../diskio.h"
+
+static struct timespec t0;
+
+static void start(void)
+{
+    DWORD nc, ns;
+
+    disk_host_stats(&nc, &ns);
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+}
+
+static void report(const char* what, DWORD times)
+{
+    struct timespec t1;
+    DWORD nc, ns;
+    double us;
+
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    disk_host_stats(&nc, &ns);
+    us = (t1.tv_sec - t0.tv_sec) * 1e6 + (t1.tv_nsec - t0.tv_nsec) / 1e3;
+    printf("%-34s %9.1f us %9.1f cmds %10.1f SPI bytes  (each of %lu)\n", what,
+           us / times, (double)nc / times, (double)ns / times, (unsigned long)times);
+}
+
+static DWORD readAll(const char* path)
+{
+    static BYTE buf[4096];
+    DWORD total = 0;
+    UINT br;
+
+    if (pf_open(path) != FR_OK) return 0;
+    do {
+        if (pf_read(buf, sizeof(buf), &br) != FR_OK) return 0;
+        total += br;
+    } while (br == sizeof(buf));
+    return total;
+}
+
+static void seeks(int mapped, DWORD n)
+{
+    static CLUST map[3000];     // FRAG.BIN has a run every 3 clusters
+    static FIL fil;
+    BYTE b[4];
+    UINT br;
+    DWORD i, seed = 1;
+
+    map[0] = sizeof(map) / sizeof(map[0]);
+    fil.cltbl = mapped ? map : 0;
+    pf_fopen(&fil, "FRAG.BIN");
+    start();
+    for (i = 0; i < n; i++) {
+        seed = seed * 1103515245 + 12345;
+        pf_flseek(&fil, (seed >> 8) % fil.fsize);
+        pf_fread(&fil, b, sizeof(b), &br);
+    }
+    report(mapped ? "seek + 4 byte read, link map" : "seek + 4 byte read, FAT chain", n);
+}
+
+int main(int argc, char** argv)
+{
+    static FATFS fs;
+    DIR dir;
+    FILINFO fno;
+    DWORD n, files = 0, bytes;
+    char name[13];
+
+    disk_host_image(argv[1]);
+    if (argc > 2) disk_host_latency(atol(argv[2]));
+
+    start();
+    if (pf_mount(&fs) != FR_OK) {
+        printf("mount failed\n");
+        return 1;
+    }
+    report("mount", 1);
+
+    start();
+    pf_opendir(&dir, "");
+    while (pf_readdir(&dir, &fno) == FR_OK && fno.fname[0]) files++;
+    report("directory scan", 1);
+    printf("  %lu entries\n", (unsigned long)files);
+
+    start();
+    for (n = 0; n < 100; n++) {
+        sprintf(name, "FILL%04lu.TXT", (unsigned long)(files > 2 ? (n * 37) % (files - 2) : 0));
+        pf_open(name);
+    }
+    report("pf_open by name", 100);
+
+    start();
+    bytes = readAll("BIG.BIN");
+    report("sequential read, contiguous", 1);
+    printf("  %lu bytes\n", (unsigned long)bytes);
+    start();
+    bytes = readAll("FRAG.BIN");
+    report("sequential read, fragmented", 1);
+    printf("  %lu bytes\n", (unsigned long)bytes);
+
+    seeks(0, 1000);
+    seeks(1, 1000);
+    return 0;
+}
@@ -0,0 +1,120 @@
+/*
+ * File:   bench_wav.c (host build)
+ *
+ * Times the per-sample work of the refill loop: the forwarding sinks
+ * that turn card data into DAC words, IMA ADPCM decoding among them, and
+ * mixing 1, 2, 4 and 8 sound effect voices over the track.  The voices
+ * are fed from RAM as clips in program flash are, so the card's share of
+ * the time is left out.
+ * Times are CPU cycles of the PC (the time stamp counter on x86,
+ * nanoseconds elsewhere), so the ratio to the 16-bit PCM sink, which
+ * the board is known to keep up with, means more than the figures.
+ *
+ * Usage: bench_wav file.wav  (an IMA ADPCM file with 256 byte blocks)
+ */
+
+#include <time.h>
+#include "../waveReader.c"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define benchUnit "PC cycles"
+static unsigned long long now(void) { return __rdtsc(); }
+#else
+#define benchUnit "ns"
+static unsigned long long now(void)
+{
+    struct timespec t;
+
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec * 1000000000ULL + t.tv_nsec;
+}
+#endif
+
+#define benchRuns 200
+
+static BYTE data[1 << 20];
+static WORD out[1 << 21];
+
+/* Feed 'len' bytes to 'sink' benchRuns times and return the least time
+ * taken for each DAC word stored. */
+static double timeSink(void (*sink)(BYTE d), UINT align, DWORD len)
+{
+    unsigned long long t, best = ~0ULL;
+    DWORD i, words = 0;
+    int r;
+
+    for (r = 0; r < benchRuns; r++) {
+        fillPos = out;
+        fillPhase = 0;
+        adpcmPos = 0;
+        adpcmBlockAlign = align;
+        t = now();
+        for (i = 0; i < len; i++) sink(data[i]);
+        t = now() - t;
+        if (t < best) best = t;
+        words = (DWORD)(fillPos - out);
+    }
+    return (double)best / words;
+}
+
+/* Mix 'n' voices of 16-bit samples into the blocks waiting in the ring
+ * benchRuns times and return the least time taken for each DAC word. */
+static double timeMix(BYTE n)
+{
+    unsigned long long t, best = ~0ULL;
+    WAVVOICE* v;
+    BYTE i;
+    int r;
+
+    for (i = 0; i < ringBlocks; i++) ringLen[i] = blockSamples;
+    for (r = 0; r < benchRuns; r++) {
+        ringTail = 0;
+        ringHead = ringBlocks - 1;
+        for (i = 0; i < mixVoices; i++) {
+            v = &voices[i];
+            v->flash = data;
+            v->dataOfs = 0;
+            v->samples = sizeof(data) / 2;
+            v->bits = 16;
+            v->gain = mixUnity / 2;
+            v->pos = v->skip = 0;
+            v->blk = 0;
+            v->on = i < n;
+        }
+        t = now();
+        mixQueued(ringHead);
+        t = now() - t;
+        if (t < best) best = t;
+    }
+    return (double)best / ((ringBlocks - 1) * blockSamples);
+}
+
+int main(int argc, char** argv)
+{
+    FILE* f = fopen(argv[1], "rb");
+    DWORD len, ofs;
+    double pcm, adpcm;
+    BYTE n;
+
+    if (!f) {
+        printf("%s: can't open\n", argv[1]);
+        return 1;
+    }
+    len = fread(data, 1, sizeof(data), f);
+    fclose(f);
+    for (ofs = 12; ofs + 8 < len && memcmp(data + ofs, "data", 4); ofs += 8 + (data[ofs + 4] | data[ofs + 5] << 8));
+    len -= ofs + 8;
+    memmove(data, data + ofs + 8, len);
+    len -= len % 256;           // Whole blocks
+
+    pcm = timeSink(fwdPcm16, 2, len);
+    adpcm = timeSink(fwdAdpcm, 256, len);
+    printf("16-bit PCM sink           %6.2f %s per sample\n", pcm, benchUnit);
+    printf("IMA ADPCM decode          %6.2f %s per sample, %.2f times PCM\n", adpcm, benchUnit, adpcm / pcm);
+    for (n = 1; n <= mixVoices; n *= 2) {
+        printf("mixing %u voice%s           %6.2f %s per sample\n", n, n > 1 ? "s" : " ",
+                timeMix(n), benchUnit);
+    }
+    return 0;
+}
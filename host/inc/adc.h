@@ -0,0 +1 @@
+/* adc.h (host build): nothing of the ADC library is used. */
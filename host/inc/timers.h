@@ -0,0 +1,27 @@
+/*
+ * File:   timers.h (host build)
+ *
+ * The XC8 peripheral library calls waveReader.c makes, see host/sim.c.
+ */
+
+#ifndef HOST_TIMERS_H
+#define HOST_TIMERS_H
+
+#define TIMER_INT_OFF 0xFF
+#define TIMER_GATE_OFF 0xFF
+#define T1_16BIT_RW 0xFF
+#define T1_SOURCE_FOSC_4 0xFF
+#define T1_PS_1_1 0xFF
+#define T1_OSC1EN_OFF 0xFF
+#define T1_SYNC_EXT_OFF 0xFF
+#define T3_16BIT_RW 0xFF
+#define T3_SOURCE_FOSC_4 0xFF
+#define T3_PS_1_8 0xFF
+#define T3_OSC1EN_OFF 0xFF
+#define T3_SYNC_EXT_OFF 0xFF
+
+void OpenTimer1(unsigned char config, unsigned char config1);
+void OpenTimer3(unsigned char config, unsigned char config1);
+void CloseTimer2(void);
+
+#endif
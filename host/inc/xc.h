@@ -0,0 +1,63 @@
+/*
+ * File:   xc.h (host build)
+ *
+ * Stands in for the XC8 device header when waveReader.c is built on a PC
+ * (see host/Makefile).  The special function registers it uses are plain
+ * variables defined in host/sim.c, and the interrupt qualifiers vanish,
+ * so the ISR is an ordinary function that host/sim.c calls once a tick.
+ * Bytes written to SSP2BUF go to the DAC mock, see simSsp2().
+ */
+
+#ifndef HOST_XC_H
+#define HOST_XC_H
+
+#define interrupt
+#define high_priority
+#define low_priority
+
+typedef struct {
+    unsigned TMR2IE : 1;
+    unsigned TX2IE : 1;
+} PIEbits_t;
+
+typedef struct {
+    unsigned TMR2IF : 1;
+    unsigned TX2IF : 1;
+    unsigned SSP2IF : 1;
+} PIRbits_t;
+
+typedef struct {
+    unsigned TMR2IP : 1;
+    unsigned TX2IP : 1;
+    unsigned RC2IP : 1;
+} IPRbits_t;
+
+typedef struct {
+    unsigned RB0 : 1;
+    unsigned RB1 : 1;
+    unsigned RB2 : 1;
+} PORTBbits_t;
+
+typedef struct {
+    unsigned TRISB0 : 1;
+    unsigned TRISB1 : 1;
+    unsigned TRISB2 : 1;
+} TRISBbits_t;
+
+typedef struct {
+    unsigned IPEN : 1;
+} RCONbits_t;
+
+extern volatile unsigned short TMR1, TMR3;
+extern volatile unsigned char TMR2, PR2, T2CON, INTCON, TXREG2;
+extern volatile PIEbits_t PIE1bits, PIE3bits;
+extern volatile PIRbits_t PIR1bits, PIR3bits;
+extern volatile IPRbits_t IPR1bits, IPR3bits;
+extern volatile PORTBbits_t PORTBbits;
+extern volatile TRISBbits_t TRISBbits;
+extern volatile RCONbits_t RCONbits;
+
+unsigned char* simSsp2(void);
+#define SSP2BUF (*simSsp2())
+
+#endif
@@ -0,0 +1,101 @@
+#!/usr/bin/env python3
+#
+# File:   mkimg.py (host build)
+#
+# Makes a FAT16 card image for diskio_host.c out of files on the PC.
+#
+# Usage: python3 mkimg.py out.img [--fill N] [--csize S] [--index R] file[:frag] ...
+#
+# Files go in the root directory in the order given.  A file marked :frag
+# is fragmented, a free cluster being left after every third one.
+# --fill adds N small files (FILLnnnn.TXT) to the directory first, so
+# lookups and directory scans have something to get through.  --csize
+# sets the sectors per cluster (1 by default).  --index adds an empty
+# PLAYLIST.IDX after the files, with room for the header and R records.
+#
+
+import os
+import struct
+import sys
+
+SECT = 512
+
+
+def main(argv):
+    if len(argv) < 2:
+        sys.exit("usage: mkimg.py out.img [--fill N] [--csize S] [--index R] file[:frag] ...")
+    out = argv[1]
+    fill, csize, index, files = 0, 1, None, []
+    args = iter(argv[2:])
+    for a in args:
+        if a == "--fill":
+            fill = int(next(args))
+        elif a == "--csize":
+            csize = int(next(args))
+        elif a == "--index":
+            index = int(next(args))
+        else:
+            path, _, frag = a.partition(":")
+            files.append((os.path.basename(path), open(path, "rb").read(), frag == "frag"))
+    files = [("FILL%04u.TXT" % i, b"fill %u\n" % i, False) for i in range(fill)] + files
+    if index is not None:
+        files.append(("PLAYLIST.IDX", bytes(64 * (index + 1)), False))
+
+    clus = SECT * csize
+    need = sum((len(d) + clus - 1) // clus * (4 if f else 3) // 3 + 1 for _, d, f in files)
+    nclus = max(4200, need + 64)                # FAT16 needs over 4084 clusters
+    rootent = max(512, (len(files) + 15) // 16 * 16)
+    fatsz = ((nclus + 2) * 2 + SECT - 1) // SECT
+    rsvd, nfats = 1, 2
+    rootsec = rsvd + nfats * fatsz
+    datasec = rootsec + rootent * 32 // SECT
+    total = datasec + nclus * csize
+    img = bytearray(total * SECT)
+
+    bs = bytearray(SECT)
+    bs[0:3] = b"\xEB\x3C\x90"
+    bs[3:11] = b"MSWIN4.1"
+    struct.pack_into("<HBHBHHBHHHLL", bs, 11, SECT, csize, rsvd, nfats, rootent,
+                     total if total < 65536 else 0, 0xF8, fatsz, 32, 2, 0,
+                     total if total >= 65536 else 0)
+    bs[54:62] = b"FAT16   "
+    bs[510], bs[511] = 0x55, 0xAA
+    img[0:SECT] = bs
+
+    fat = [0] * (nclus + 2)
+    fat[0], fat[1] = 0xFFF8, 0xFFFF
+    nextc = 2
+    ents = []
+    for name, data, frag in files:
+        n = (len(data) + clus - 1) // clus
+        cl = []
+        for i in range(n):
+            if frag and i and i % 3 == 0:
+                nextc += 1                      # Leave a hole
+            cl.append(nextc)
+            nextc += 1
+        for a, b in zip(cl, cl[1:] + [0xFFFF]):
+            fat[a] = b
+        for i, c in enumerate(cl):
+            ofs = (datasec + (c - 2) * csize) * SECT
+            chunk = data[i * clus:(i + 1) * clus]
+            img[ofs:ofs + len(chunk)] = chunk
+        base, _, ext = name.upper().partition(".")
+        e = bytearray(32)
+        e[0:11] = (base.ljust(8)[:8] + ext.ljust(3)[:3]).encode()
+        e[11] = 0x20
+        struct.pack_into("<HHHL", e, 22, 0x6000, 0x4A21, cl[0] if cl else 0, len(data))
+        ents.append(e)
+
+    fatb = struct.pack("<%uH" % len(fat), *fat)
+    for k in range(nfats):
+        ofs = (rsvd + k * fatsz) * SECT
+        img[ofs:ofs + len(fatb)] = fatb
+    for i, e in enumerate(ents):
+        ofs = rootsec * SECT + i * 32
+        img[ofs:ofs + 32] = e
+    open(out, "wb").write(img)
+
+
+if __name__ == "__main__":
+    main(sys.argv)
@@ -0,0 +1,146 @@
+#!/usr/bin/env python3
+#
+# File:   mkwav.py (host build)
+#
+# Makes test WAV files: a mix of tones with a little noise, so every
+# sample differs from the last.
+#
+# Usage: python3 mkwav.py out.wav [--rate R] [--bits 8|16] [--stereo]
+#                         [--adpcm] [--secs S] [--seed N]
+#                         [--extensible] [--chunks c,c,...]
+#
+# --adpcm writes mono IMA ADPCM (WAVE_FORMAT_IMA_ADPCM) with 256 byte
+# blocks, and also out.wav.ref, the 16-bit samples a decoder must give.
+# --extensible writes PCM as WAVE_FORMAT_EXTENSIBLE.  --chunks gives the
+# chunks and their order, out of fmt, data, fact, LIST, bext, smpl, cue
+# and junk (fmt,data by default, fmt,fact,data for --adpcm); LIST and junk
+# are of odd length, so a pad byte follows them.  out.wav.ofs is written
+# too, holding the file offset and length of the data, smpl and cue
+# chunks' contents (0 for one left out).
+#
+
+import math
+import random
+import struct
+import sys
+
+STEP = [
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+    50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230,
+    253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963,
+    1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327,
+    3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442,
+    11487, 12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794,
+    32767]
+INDEX_ADJ = [-1, -1, -1, -1, 2, 4, 6, 8]
+
+
+def chunk(cid, body):
+    """A chunk, with the pad byte after an odd length body."""
+    return cid + struct.pack("<I", len(body)) + body + (b"\0" if len(body) & 1 else b"")
+
+
+def adpcm_encode(samples, block_align):
+    """Encode mono 16-bit samples, returning the data and the decoded samples."""
+    per_block = (block_align - 4) * 2 + 1
+    data, dec = bytearray(), []
+    index = 0
+    for b in range(0, len(samples), per_block):
+        blk = samples[b:b + per_block]
+        pred = blk[0]
+        data += struct.pack("<hBB", pred, index, 0)
+        dec.append(pred)
+        nibbles = []
+        for s in blk[1:]:
+            step = STEP[index]
+            diff = s - pred
+            n = 0
+            if diff < 0:
+                n, diff = 8, -diff
+            for bit, scale in ((4, step), (2, step >> 1), (1, step >> 2)):
+                if diff >= scale:
+                    n |= bit
+                    diff -= scale
+            step = STEP[index]
+            d = step >> 3
+            if n & 4: d += step
+            if n & 2: d += step >> 1
+            if n & 1: d += step >> 2
+            pred = max(-32768, pred - d) if n & 8 else min(32767, pred + d)
+            index = min(88, max(0, index + INDEX_ADJ[n & 7]))
+            nibbles.append(n)
+            dec.append(pred)
+        if len(nibbles) & 1:
+            nibbles.append(0)
+        for i in range(0, len(nibbles), 2):
+            data.append(nibbles[i] | nibbles[i + 1] << 4)
+    return bytes(data), dec
+
+
+def main(argv):
+    out = argv[1]
+    rate, bits, stereo, adpcm, secs, seed = 22050, 16, False, False, 1.0, 1
+    extensible, order = False, None
+    args = iter(argv[2:])
+    for a in args:
+        if a == "--rate": rate = int(next(args))
+        elif a == "--bits": bits = int(next(args))
+        elif a == "--stereo": stereo = True
+        elif a == "--adpcm": adpcm = True
+        elif a == "--secs": secs = float(next(args))
+        elif a == "--seed": seed = int(next(args))
+        elif a == "--extensible": extensible = True
+        elif a == "--chunks": order = next(args).split(",")
+    rnd = random.Random(seed)
+    n = int(rate * secs)
+    chans = 2 if stereo else 1
+    frames = []
+    for i in range(n):
+        frame = []
+        for c in range(chans):
+            v = 0.5 * math.sin(2 * math.pi * (440 + 110 * c) * i / rate) \
+                + 0.2 * math.sin(2 * math.pi * 1234 * i / rate) + rnd.uniform(-0.05, 0.05)
+            frame.append(max(-32768, min(32767, int(v * 32767))))
+        frames.append(frame)
+
+    if adpcm:
+        align = 256
+        data, dec = adpcm_encode([f[0] for f in frames], align)
+        fmt = struct.pack("<HHIIHHHH", 0x11, 1, rate, rate * align // ((align - 4) * 2 + 1),
+                          align, 4, 2, (align - 4) * 2 + 1)
+        open(out + ".ref", "wb").write(struct.pack("<%uh" % len(dec), *dec)[:2 * n])
+        order = order or ["fmt", "fact", "data"]
+    else:
+        width = bits // 8
+        if bits == 8:
+            data = bytes((s >> 8) + 128 for f in frames for s in f)
+        else:
+            data = struct.pack("<%uh" % (n * chans), *[s for f in frames for s in f])
+        fmt = struct.pack("<HHIIHH", 0xFFFE if extensible else 1, chans, rate,
+                          rate * width * chans, width * chans, bits)
+        if extensible:
+            fmt += struct.pack("<HHIH", 22, bits, 3 if stereo else 4, 1) \
+                + bytes.fromhex("000000001000800000aa00389b71")
+        order = order or ["fmt", "data"]
+
+    chunks = {
+        "fmt": (b"fmt ", fmt),
+        "data": (b"data", data),
+        "fact": (b"fact", struct.pack("<I", n)),
+        "LIST": (b"LIST", b"INFOINAM\x05\0\0\0test\0"),
+        "bext": (b"bext", bytes(602)),
+        "smpl": (b"smpl", struct.pack("<9I", 0, 0, 1000000000 // rate, 60, 0, 0, 0, 0, 0)),
+        "cue": (b"cue ", struct.pack("<I", 1) + struct.pack("<II4sIII", 1, 0, b"data", 0, 0, 0)),
+        "junk": (b"junk", bytes(7)),
+    }
+    body, ofs = b"WAVE", {}
+    for c in order:
+        cid, b = chunks[c]
+        ofs[c] = (8 + len(body) + 8, len(b))     # After RIFF, size and what is in body
+        body += chunk(cid, b)
+    open(out, "wb").write(b"RIFF" + struct.pack("<I", len(body)) + body)
+    open(out + ".ofs", "w").write(" ".join("%u %u" % ofs.get(c, (0, 0)) for c in ("data", "smpl", "cue")) + "\n")
+
+
+if __name__ == "__main__":
+    main(sys.argv)
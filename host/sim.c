@@ -0,0 +1,272 @@
+/*
+ * File:   sim.c (host build)
+ *
+ * The registers and library calls of host/inc, a mock of the DAC and a
+ * sample tick simulator, so waveReader.c can be run and measured on a PC
+ * against a card image served by diskio_host.c.
+ *
+ * Time is counted in sample ticks.  simTick runs the ISR, as Timer2 does,
+ * and adds the period it programmed to simTickCycles.  playWav calls
+ * simPoll every time round its loop (see hostPoll in waveReader.c), which
+ * runs simTicksPerPass ticks, so a larger value stands for a slower main
+ * loop.  The ISR's DAC words come out of MSSP2 or, in the bit-banged
+ * build, a bit at a time through simSckPulse, and are collected in simDac.
+ *
+ * Builds with SIM_COMLOG set link comLog.c in place of the comPrintf
+ * here, and simTick runs its low priority ISR as USART2 takes each
+ * character, timed against the ticks (see comLate).
+ */
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <xc.h>
+#include <timers.h>
+#include "sim.h"
+
+void dacInterrupt(void);
+#ifdef SIM_COMLOG
+void comInterrupt(void);
+#endif
+
+volatile unsigned short TMR1, TMR3;
+volatile unsigned char TMR2, PR2, T2CON, INTCON, TXREG2;
+volatile PIEbits_t PIE1bits, PIE3bits;
+volatile PIRbits_t PIR1bits, PIR3bits;
+volatile IPRbits_t IPR1bits, IPR3bits;
+volatile PORTBbits_t PORTBbits;
+volatile TRISBbits_t TRISBbits;
+volatile RCONbits_t RCONbits;
+
+WORD simDac[simDacMax];
+DWORD simDacCount;
+DWORD simDacErrors;
+DWORD simTicks;
+DWORD simTickCycles;
+DWORD simMarkTicks;
+DWORD simMarkCycles;
+WORD simTicksPerPass = 16;
+BYTE simVerbose;
+void (*simLine)(const char* line);
+void (*simPass)(void);
+WORD simBytesPerTick;
+DWORD simComRuns;
+#ifndef SIM_COMLOG
+WORD comDropped;
+#endif
+
+static BYTE dacHigh;            // First byte of a word, waiting for the second
+static BYTE dacPhase;
+static BYTE sspByte;
+static int failures;
+
+/*-----------------------------------------------------------------------
+ * The DAC mock.  Each write to SSP2BUF lands here a byte at a time, two
+ * bytes to a word, high byte first.  A byte written while chip select is
+ * high is counted as an error, as is an ISR run that leaves half a word
+ * or chip select low (see simTick).  The byte written is picked up on the next
+ * write, or by simTick once the ISR has returned.
+ *-----------------------------------------------------------------------*/
+static void dacTake(void)
+{
+    if (!dacPhase) {
+        dacHigh = sspByte;
+        dacPhase = 1;
+        return;
+    }
+    dacPhase = 0;
+    if (simDacCount < simDacMax) simDac[simDacCount++] = (WORD)dacHigh << 8 | sspByte;
+}
+
+static BYTE sspPending;
+static DWORD comAt;             // Cycle the COM ISR runs next, see comLate
+static DWORD comLast;           // Cycle the last tick fell due
+static BYTE comOn;              // Set while USART2 is sending
+static WORD bbWord;             // Bits clocked in so far, bit-banged build
+static BYTE bbBits;
+
+unsigned char* simSsp2(void)
+{
+    if (sspPending) dacTake();
+    if (PORTBbits.RB0) simDacErrors++;
+    sspPending = 1;
+    PIR3bits.SSP2IF = 1;        // The byte shifts out at once
+    return &sspByte;
+}
+
+/*-----------------------------------------------------------------------
+ * The DAC mock of the bit-banged build (dacSckPulse is this there).  The
+ * DAC latches SDI on each rising clock edge while chip select is low and
+ * takes 16 bits to a word.  A clock with chip select high is an error.
+ *-----------------------------------------------------------------------*/
+void simSckPulse(void)
+{
+    if (PORTBbits.RB0) {
+        simDacErrors++;
+        return;
+    }
+    bbWord = bbWord << 1 | PORTBbits.RB2;
+    if (++bbBits == 16) {
+        bbBits = 0;
+        if (simDacCount < simDacMax) simDac[simDacCount++] = bbWord;
+    }
+}
+
+void OpenTimer1(unsigned char config, unsigned char config1)
+{
+    (void)config;
+    (void)config1;
+}
+
+void OpenTimer3(unsigned char config, unsigned char config1)
+{
+    (void)config;
+    (void)config1;
+}
+
+void CloseTimer2(void)
+{
+    T2CON = 0;
+    PIE1bits.TMR2IE = 0;
+}
+
+#ifndef SIM_COMLOG
+void comPrintf(const char* fmt, ...)
+{
+    va_list ap;
+    char line[256];
+
+    va_start(ap, fmt);
+    vsnprintf(line, sizeof(line), fmt, ap);
+    va_end(ap);
+    if (simLine) simLine(line);
+    if (simVerbose) fputs(line, stdout);
+}
+#endif
+
+/*-----------------------------------------------------------------------
+ * Start over: no DAC words, no ticks, the ISR off.
+ *-----------------------------------------------------------------------*/
+void simReset(void)
+{
+    simDacCount = simDacErrors = 0;
+    simTicks = simTickCycles = simMarkCycles = 0;
+    dacPhase = sspPending = bbBits = 0;
+    simComRuns = comAt = comLast = comOn = 0;
+    PORTBbits.RB0 = 1;
+    PIE1bits.TMR2IE = 0;
+    T2CON = 0;
+}
+
+#define charCycles 2083         // USART2 sends a character in 260 us at 38400 baud
+#define comCycles 60            // A comInterrupt run, context saving included (estimated)
+
+/*-----------------------------------------------------------------------
+ * Run the COM ISR for every character USART2 was ready to take up to
+ * cycle 'now', when a tick falls due, and return how many cycles the
+ * tick waits for it.  It only waits if the last run is still going then
+ * and the tick can't cut in, which it can when it is high priority and
+ * the COM ISR low (see init_COM).
+ *-----------------------------------------------------------------------*/
+#ifdef SIM_COMLOG
+static DWORD comLate(DWORD now)
+{
+    DWORD wait = 0;
+
+    if (!PIE3bits.TX2IE) {
+        comOn = 0;
+    } else if (!comOn) {        // Queued half way between the ticks
+        comAt = comLast + (now - comLast) / 2;
+        comOn = 1;
+    }
+    comLast = now;
+    PIR3bits.TX2IF = 1;
+    while (comOn && comAt <= now) {
+        comInterrupt();
+        simComRuns++;
+        if (comAt + comCycles > now) wait = comAt + comCycles - now;
+        comAt += charCycles;
+        if (!PIE3bits.TX2IE) comOn = 0;
+    }
+    if (RCONbits.IPEN && IPR1bits.TMR2IP && !IPR3bits.TX2IP) wait = 0;
+    return wait;
+}
+#else
+#define comLate(now) 0
+#endif
+
+/*-----------------------------------------------------------------------
+ * One sample tick.  The ISR sets PR2 for the period starting now, which
+ * lasts (PR2 + 1) counts times the Timer2 prescaler and postscaler.  It
+ * finds Timer2 as far into the period as the interrupt latency, and any
+ * wait for the COM ISR, took it (see comLate).
+ *-----------------------------------------------------------------------*/
+void simTick(void)
+{
+    static const BYTE pre[4] = {1, 4, 16, 16};
+    DWORD late;
+
+    if (!PIE1bits.TMR2IE) return;
+    late = (simIrqCycles + comLate(simTickCycles)) / pre[T2CON & 3];
+    TMR2 = late > PR2 ? PR2 : (BYTE)late;
+    dacInterrupt();
+    if (sspPending) {
+        dacTake();
+        sspPending = 0;
+    }
+    // The ISR must leave the DAC deselected after whole words
+    if (dacPhase || bbBits || !PORTBbits.RB0) simDacErrors++;
+    dacPhase = bbBits = 0;
+    simTicks++;
+    simTickCycles += (DWORD)(PR2 + 1) * pre[T2CON & 3] * ((T2CON >> 3 & 15) + 1);
+    if (simTicks == simMarkTicks) simMarkCycles = simTickCycles;
+}
+
+void simTicksRun(DWORD n)
+{
+    while (n--) simTick();
+}
+
+/*-----------------------------------------------------------------------
+ * FORWARD (see pffconf.h) of the builds that set it to this: hand the
+ * byte to the sink, and with simBytesPerTick set, run a tick after that
+ * many bytes, as Timer2 cuts into the card reads and the sinks on the
+ * board.  The ISR then finds blocks part way through being mixed.
+ *-----------------------------------------------------------------------*/
+void simForward(BYTE d)
+{
+    static WORD n;
+    extern void (*FwdSink)(BYTE d);
+
+    (*FwdSink)(d);
+    if (simBytesPerTick && ++n >= simBytesPerTick) {
+        n = 0;
+        simTick();
+    }
+}
+
+void simPoll(void)
+{
+    if (simPass) simPass();
+    simTicksRun(simTicksPerPass);
+}
+
+double simSeconds(void)
+{
+    return simTickCycles / 8e6;
+}
+
+/*-----------------------------------------------------------------------
+ * Report a check, and remember a failed one for simDone.
+ *-----------------------------------------------------------------------*/
+int simCheck(int ok, const char* what)
+{
+    printf("%s: %s\n", ok ? "ok  " : "FAIL", what);
+    if (!ok) failures++;
+    return ok;
+}
+
+int simDone(void)
+{
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,39 @@
+/*
+ * File:   sim.h (host build)
+ *
+ * Sample tick simulator for the host build of waveReader.c, see sim.c.
+ */
+
+#ifndef HOST_SIM_H
+#define HOST_SIM_H
+
+#include "../integer.h"
+
+#define simDacMax 2000000UL     // DAC words the mock keeps
+#define simIrqCycles 3          // From Timer2 matching PR2 to the ISR's first instruction
+
+extern WORD simDac[];           // DAC words sent by the ISR, in order
+extern DWORD simDacCount;       // Words in simDac
+extern DWORD simDacErrors;      // Bytes or bits sent with the DAC not selected, broken words
+extern DWORD simTicks;          // Sample ticks run
+extern DWORD simTickCycles;     // Instruction cycles of the ticks run
+extern DWORD simMarkTicks;      // simMarkCycles is simTickCycles after this many ticks
+extern DWORD simMarkCycles;
+extern WORD simTicksPerPass;    // Ticks run each time round the loop in playWav
+extern BYTE simVerbose;         // Print comPrintf output
+extern void (*simLine)(const char* line);  // Also hand it here, if set
+extern void (*simPass)(void);   // Called every time round the loop in playWav, if set
+extern WORD simBytesPerTick;    // Run a tick after every so many bytes forwarded, 0 for none
+extern DWORD simComRuns;        // COM ISR runs, SIM_COMLOG builds
+
+void simForward(BYTE d);
+void simReset(void);
+void simTick(void);
+void simSckPulse(void);
+void simTicksRun(DWORD n);
+void simPoll(void);
+double simSeconds(void);
+int simCheck(int ok, const char* what);
+int simDone(void);
+
+#endif
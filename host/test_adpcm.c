@@ -0,0 +1,43 @@
+/*
+ * File:   test_adpcm.c (host build)
+ *
+ * Plays IMA ADPCM files and checks every DAC word against the decoder
+ * in mkwav.py, which wrote the 16-bit samples it expects to file.ref.
+ *
+ * Usage: test_adpcm card.img file.wav ...  (the files in directory order)
+ */
+
+#include "../waveReader.c"
+#include "../diskio.h"
+
+int main(int argc, char** argv)
+{
+    FATFS fs;
+    static short ref[2000000];
+    DWORD at = 0, bad, n, i;
+    char path[300], what[300];
+    FILE* f;
+    int k;
+
+    disk_host_image(argv[1]);
+    if (!simCheck(pf_mount(&fs) == FR_OK, "mount")) return simDone();
+    simReset();
+    simCheck(rootPlay() == FR_OK, "rootPlay played the directory");
+
+    for (k = 2; k < argc; k++) {
+        sprintf(path, "%s.ref", argv[k]);
+        f = fopen(path, "rb");
+        if (!simCheck(f != 0, path)) continue;
+        n = fread(ref, 2, sizeof(ref) / 2, f);
+        fclose(f);
+        for (i = 0, bad = 0; i < n; i++, at++) {
+            WORD want = dacConfig | (WORD)(ref[i] ^ 0x8000) >> 4;
+            if (at >= simDacCount || simDac[at] != want) bad++;
+        }
+        sprintf(what, "%s: %lu samples, %lu wrong", argv[k], (unsigned long)n, (unsigned long)bad);
+        simCheck(bad == 0, what);
+    }
+    sprintf(what, "%lu DAC words sent, %lu expected", (unsigned long)simDacCount, (unsigned long)at);
+    simCheck(simDacCount == at && simDacErrors == 0, what);
+    return simDone();
+}
@@ -0,0 +1,50 @@
+/*
+ * File:   test_announce.c (host build)
+ *
+ * Checks playWav says "Playing ..." for each file as it starts to be
+ * heard: after the DAC has had every sample of the files before it, and
+ * within a couple of passes round the loop in playWav.
+ *
+ * Usage: test_announce card.img samples ...  (of each file, in order)
+ */
+
+#include <stdlib.h>
+#include "../waveReader.c"
+#include "../diskio.h"
+
+#define maxFiles 16
+
+static DWORD heard[maxFiles];   // DAC words sent when each file was announced
+static int said;
+
+static void onLine(const char* line)
+{
+    if (!strncmp(line, "Playing ", 8) && said < maxFiles) heard[said++] = simDacCount;
+}
+
+int main(int argc, char** argv)
+{
+    FATFS fs;
+    DWORD start = 0;
+    int k;
+    char what[200];
+
+    disk_host_image(argv[1]);
+    if (!simCheck(pf_mount(&fs) == FR_OK, "mount")) return simDone();
+    simReset();
+    simLine = onLine;
+    rootPlay();
+
+    sprintf(what, "%d files announced, %d played", said, argc - 2);
+    simCheck(said == argc - 2, what);
+    for (k = 0; k < said && k + 2 < argc; k++) {
+        // The first is announced by rootPlay before it starts
+        if (k) {
+            sprintf(what, "file %d announced after %lu samples, starts at %lu", k + 1,
+                    (unsigned long)heard[k], (unsigned long)start);
+            simCheck(heard[k] >= start && heard[k] <= start + 2 * simTicksPerPass, what);
+        }
+        start += atol(argv[k + 2]);
+    }
+    return simDone();
+}
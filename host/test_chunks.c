@@ -0,0 +1,73 @@
+/*
+ * File:   test_chunks.c (host build)
+ *
+ * Hands parseWav files whose chunks come in other orders than fmt, data:
+ * LIST and bext before fmt, data before fmt, cue before data, chunks of
+ * odd length with their pad byte, and WAVE_FORMAT_EXTENSIBLE.  Checks it
+ * finds the data, smpl and cue chunks where mkwav.py put them (see
+ * out.wav.ofs), takes the extensible files as PCM and leaves each file
+ * at its first sample.  Then plays the card through to check they all
+ * play to the end.
+ *
+ * Usage: test_chunks card.img file.wav ...  (the files in directory order)
+ */
+
+#include <stdlib.h>
+#include "../waveReader.c"
+#include "../diskio.h"
+
+static const char* base(const char* path)
+{
+    const char* p = strrchr(path, '/');
+
+    return p ? p + 1 : path;
+}
+
+int main(int argc, char** argv)
+{
+    FATFS fs;
+    WAVINDEX rec;
+    unsigned long want[6];      // Offset and length of data, smpl and cue
+    DWORD samples = 0;
+    FILE* f;
+    int k, n;
+    char path[300], what[300];
+
+    disk_host_image(argv[1]);
+    if (!simCheck(pf_mount(&fs) == FR_OK, "mount")) return simDone();
+
+    for (k = 2; k < argc; k++) {
+        sprintf(path, "%s.ofs", argv[k]);
+        f = fopen(path, "r");
+        n = f ? fscanf(f, "%lu %lu %lu %lu %lu %lu", &want[0], &want[1], &want[2],
+                       &want[3], &want[4], &want[5]) : 0;
+        if (f) fclose(f);
+        if (n != 6) {
+            simCheck(0, path);
+            continue;
+        }
+        if (pf_fopen(&trackFil, base(argv[k])) != FR_OK || parseWav(&trackFil, &rec) != FR_OK) {
+            simCheck(0, base(argv[k]));
+            continue;
+        }
+        sprintf(what, "%s: data %lu+%lu, smpl %lu+%lu, cue %lu+%lu, %s, at %lu", base(argv[k]),
+                (unsigned long)rec.dataOfs, (unsigned long)rec.dataLen,
+                (unsigned long)rec.smplOfs, (unsigned long)rec.smplLen,
+                (unsigned long)rec.cueOfs, (unsigned long)rec.cueLen,
+                rec.format == WAVE_FORMAT_PCM ? "PCM" : "IMA ADPCM",
+                (unsigned long)pf_ftell(&trackFil));
+        simCheck(rec.dataOfs == want[0] && rec.dataLen == want[1]
+                 && rec.smplOfs == want[2] && rec.smplLen == want[3]
+                 && rec.cueOfs == want[4] && rec.cueLen == want[5]
+                 && (rec.format == WAVE_FORMAT_PCM || rec.format == WAVE_FORMAT_IMA_ADPCM)
+                 && pf_ftell(&trackFil) == rec.dataOfs, what);
+        samples += rec.samples;
+    }
+
+    simReset();
+    simCheck(rootPlay() == FR_OK, "rootPlay played the directory");
+    sprintf(what, "%lu DAC words sent, %lu in the files", (unsigned long)simDacCount,
+            (unsigned long)samples);
+    simCheck(simDacCount == samples && wavStats.underruns == 0, what);
+    return simDone();
+}
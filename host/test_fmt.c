@@ -0,0 +1,45 @@
+/*
+ * File:   test_fmt.c (host build)
+ *
+ * Hands checkFmt fmt chunks that should and shouldn't play, the ones
+ * with no channels or empty blocks among them, which parseWav and
+ * startTrack would otherwise divide by.
+ */
+
+#include "../waveReader.c"
+
+static void check(const char* what, WORD compress, WORD channels, DWORD rate, WORD blockAlign,
+                  WORD bits, WORD samplesPerBlock, FRESULT want)
+{
+    WAVFMT fmt;
+    WAVINDEX rec;
+    FRESULT res;
+    char line[200];
+
+    memset(&fmt, 0, sizeof(fmt));
+    fmt.compress = compress;
+    fmt.channels = channels;
+    fmt.sampleRate = rate;
+    fmt.bytesPerSecond = rate * blockAlign;
+    fmt.blockAlign = blockAlign;
+    fmt.bitsPerSample = bits;
+    fmt.extraBytes = samplesPerBlock ? 2 : 0;
+    fmt.samplesPerBlock = samplesPerBlock;
+    res = checkFmt(&fmt, samplesPerBlock ? 20 : 16, &rec);
+    sprintf(line, "%s: %s", what, res == FR_OK ? "plays" : "refused");
+    simCheck(res == want, line);
+}
+
+int main(void)
+{
+    check("8-bit mono", WAVE_FORMAT_PCM, 1, 22050, 1, 8, 0, FR_OK);
+    check("16-bit stereo 48 kHz", WAVE_FORMAT_PCM, 2, 48000, 4, 16, 0, FR_OK);
+    check("IMA ADPCM mono", WAVE_FORMAT_IMA_ADPCM, 1, 22050, 256, 4, 505, FR_OK);
+    check("PCM, no channels, empty blocks", WAVE_FORMAT_PCM, 0, 22050, 0, 8, 0, FR_WAV_TYPE_UNSUPPORTED);
+    check("PCM, no channels", WAVE_FORMAT_PCM, 0, 22050, 1, 8, 0, FR_WAV_TYPE_UNSUPPORTED);
+    check("PCM, empty blocks", WAVE_FORMAT_PCM, 1, 22050, 0, 8, 0, FR_WAV_TYPE_UNSUPPORTED);
+    check("IMA ADPCM, no channels", WAVE_FORMAT_IMA_ADPCM, 0, 22050, 256, 4, 505, FR_WAV_TYPE_UNSUPPORTED);
+    check("3 channels", WAVE_FORMAT_PCM, 3, 22050, 3, 8, 0, FR_WAV_TYPE_UNSUPPORTED);
+    check("too slow", WAVE_FORMAT_PCM, 1, 1000, 1, 8, 0, FR_WAV_TYPE_UNSUPPORTED);
+    return simDone();
+}
@@ -0,0 +1,127 @@
+/*
+ * File:   test_hot.c (host build)
+ *
+ * Plays a track with a hot clip started part way through a block, and
+ * checks every DAC word from the next block on is the track's sample
+ * plus the clip's at the level it was loaded at, clipped: the attack the
+ * ISR adds from RAM, at 8 bits, and the rest mixed from the card at full
+ * resolution, with nothing dropped or doubled where one hands over to
+ * the other.  Once with an 8-bit clip below mixUnity and once with a
+ * 16-bit one above it, which clips.  Then the 16-bit one again with a
+ * tick run after every byte read from the card (and one a pass), so the
+ * ISR catches up with blocks while the clip is mixed into them: it must
+ * wait for them (an underrun) rather than play them half mixed.
+ *
+ * Usage: test_hot card.img track.wav clip8.wav clip16.wav
+ *   (the files on the PC; the card has them under the same names)
+ */
+
+#include "../waveReader.c"
+#include "../diskio.h"
+
+#define startAt 5000            // DAC words sent before the clip is started
+
+static DWORD startedAt;         // DAC words sent when it was
+static BYTE hotV;
+
+static void trigger(void)
+{
+    if (!startedAt && simDacCount >= startAt) {
+        startedAt = simDacCount;
+        wavHotPlay(hotV);
+    }
+}
+
+/* Data chunk of a WAV file made by mkwav.py */
+static BYTE* loadData(const char* path, BYTE* buf, DWORD max, DWORD* len)
+{
+    FILE* f = fopen(path, "rb");
+    size_t n;
+
+    if (!f) return 0;
+    n = fread(buf, 1, max, f);
+    fclose(f);
+    if (n < 44) return 0;
+    *len = buf[40] | buf[41] << 8 | (DWORD)buf[42] << 16 | (DWORD)buf[43] << 24;
+    return buf + 44;
+}
+
+static const char* base(const char* path)
+{
+    const char* p = strrchr(path, '/');
+
+    return p ? p + 1 : path;
+}
+
+static void run(const char* trackPath, const char* clipPath, BYTE v, BYTE bits, BYTE gain, WORD bytesPerTick)
+{
+    static BYTE tbuf[1 << 20], cbuf[1 << 20];
+    BYTE *t, *c;
+    DWORD tlen, clen, n, i, at, bad = 0;
+    DIR dir;
+    FILINFO fno;
+    char what[300];
+
+    t = loadData(trackPath, tbuf, sizeof(tbuf), &tlen);
+    c = loadData(clipPath, cbuf, sizeof(cbuf), &clen);
+    if (!simCheck(t && c, "test files")) return;
+    sprintf(what, "%s loaded hot at level %u", base(clipPath), gain);
+    if (!simCheck(wavHotLoad(v, base(clipPath), gain) == FR_OK, what)) return;
+
+    pf_opendir(&dir, "");
+    do pf_readdir(&dir, &fno); while (fno.fname[0] && strcmp(fno.fname, base(trackPath)));
+    if (!simCheck(openWav(&fno) == FR_OK, base(trackPath))) return;
+    simReset();
+    startedAt = 0;
+    hotV = v;
+    simPass = trigger;
+    simBytesPerTick = bytesPerTick;
+    simTicksPerPass = bytesPerTick ? 1 : 16;
+    playWav(0);
+    simTicksPerPass = 16;
+    simBytesPerTick = 0;
+    simPass = 0;
+
+    /* The attack starts with the next block.  The 8-bit track is read in
+     * blocks of blockSamples bytes on the card, so the first is cut short
+     * by its 44 header bytes. */
+    at = startedAt + blockSamples - 1 - (startedAt + 44 + blockSamples - 1) % blockSamples;
+    n = clen / (bits / 8);
+    for (i = 0; i < tlen; i++) {
+        SHORT m = (SHORT)(dac8Bit[t[i]] & 0x0FFF);
+
+        if (i >= at && i - at < n) {
+            DWORD j = i - at;
+            SHORT s = bits == 8 ? ((SHORT)c[j] - 128) << 4 : (SHORT)(c[2 * j] | c[2 * j + 1] << 8) >> 4;
+
+            s = (SHORT)(((LONG)s * gain) >> 7);
+            if (j < hotLen) {                   // From RAM, rounded to 8 bits
+                s = (s + 8) >> 4;
+                if (s < -128) s = -128;
+                else if (s > 127) s = 127;
+                s *= 16;
+            }
+            m += s;
+            if (m < 0) m = 0;
+            else if (m > 0x0FFF) m = 0x0FFF;
+        }
+        if (i >= simDacCount || simDac[i] != (dacConfig | m)) bad++;
+    }
+    sprintf(what, "%s from sample %lu: %lu of %lu words wrong, %u voice blocks late, %u underruns",
+            base(clipPath), (unsigned long)at, (unsigned long)bad, (unsigned long)tlen,
+            wavStats.mixLate, wavStats.underruns);
+    simCheck(startedAt && bad == 0 && simDacCount == tlen && wavStats.mixLate == 0
+             && (bytesPerTick || wavStats.underruns == 0), what);
+}
+
+int main(int argc, char** argv)
+{
+    FATFS fs;
+
+    disk_host_image(argv[1]);
+    if (!simCheck(pf_mount(&fs) == FR_OK, "mount")) return simDone();
+    run(argv[2], argv[3], 0, 8, mixUnity * 3 / 4, 0);
+    run(argv[2], argv[4], 1, 16, 2 * mixUnity - 1, 0);
+    run(argv[2], argv[4], 1, 16, 2 * mixUnity - 1, 1);
+    return simDone();
+}
@@ -0,0 +1,172 @@
+/*
+ * File:   test_index.c (host build)
+ *
+ * Plays a card with an empty PLAYLIST.IDX through a few times and checks
+ * the playlist index: the first pass reads every file's headers and
+ * rootPlay builds the index at the end of it (written back to the card
+ * with CMD24), and the next pass starts every track from its record,
+ * without reading any headers.  A file whose date or size changes makes
+ * the index stale, so that pass reads the headers from there on and the
+ * index is built again.  On a card whose index has room for fewer
+ * records than files, the index is marked full and the files it doesn't
+ * reach are opened by their headers every pass, without it being rebuilt.
+ *
+ * Usage: test_index card.img full.img
+ *   (both with the play files and PLAYLIST.IDX last, see mkimg.py --index,
+ *   the first with room for all of them and the second for two; both are
+ *   written to)
+ */
+
+#include "../pff.h"
+
+FRESULT trackRead(FIL* fp, void* buff, UINT btr, UINT* br);
+
+#define pf_fread trackRead
+#include "../waveReader.c"
+#include "../diskio.h"
+#undef pf_fread
+
+#define playFiles 4             // Files before PLAYLIST.IDX
+#define allFiles (playFiles + 1)
+
+static DWORD headerReads;       // Reads of the track's file from its start
+static BYTE rebuilt;            // Set when rootPlay said it rebuilt the index
+
+/* Reads of a track's file from its start are reads of its headers */
+FRESULT trackRead(FIL* fp, void* buff, UINT btr, UINT* br)
+{
+    if (fp == &trackFil && fp->fptr == 0) headerReads++;
+    return pf_fread(fp, buff, btr, br);
+}
+
+static void onLine(const char* line)
+{
+    if (!strncmp(line, "Rebuilding", 10)) rebuilt = 1;
+}
+
+/* Play the card through once */
+static void pass(void)
+{
+    headerReads = 0;
+    rebuilt = 0;
+    simReset();
+    rootPlay();
+}
+
+/* Check the pass just played read 'reads' headers (any if 'reads' is -1)
+ * and rebuilt the index or not */
+static void checkPass(const char* when, long reads, BYTE build)
+{
+    char what[200];
+
+    sprintf(what, "%s: %lu header reads, %s", when, (unsigned long)headerReads,
+            rebuilt ? "index rebuilt" : "index kept");
+    simCheck((reads < 0 ? headerReads > 0 : headerReads == (DWORD)reads) && rebuilt == build, what);
+}
+
+/* Check the index on the card has 'count' records, each matching its
+ * file, and is marked full or not */
+static void checkIndex(const char* when, WORD count, BYTE full)
+{
+    DIR dir;
+    FILINFO fno;
+    const WAVINDEX* rec;
+    WORD found = 0, playable = 0;
+    char what[200];
+
+    idxOpen();
+    pf_opendir(&dir, "");
+    while (pf_readdir(&dir, &fno) == FR_OK && fno.fname[0]) {
+        rec = idxFind(&fno);
+        if (!rec) break;
+        found++;
+        if (rec->format) playable++;
+    }
+    sprintf(what, "%s: %u records%s, %u matching, %u playable", when, idxCount,
+            idxFull ? " (full)" : "", found, playable);
+    simCheck(idxState == IDX_OK && idxCount == count && idxFull == full && found == count
+             && playable == (count < playFiles ? count : playFiles), what);
+}
+
+/* Add 'dsize' to the size and 'ddate' to the date in the directory entry
+ * of 'name' (8.3, padded with spaces) on image 'img', and mount the card
+ * again so none of it stays cached */
+static void touch(const char* img, const char* name, int dsize, int ddate, FATFS* fs)
+{
+    FILE* f = fopen(img, "r+b");
+    BYTE bs[512], e[32];
+    long root;
+    WORD i, n = 0;
+    DWORD size;
+
+    if (f && fread(bs, 1, sizeof(bs), f) == sizeof(bs)) {
+        root = ((bs[14] | bs[15] << 8) + bs[16] * (long)(bs[22] | bs[23] << 8)) * 512;
+        n = bs[17] | bs[18] << 8;           // Root directory entries
+        for (i = 0; i < n; i++) {
+            fseek(f, root + i * 32L, SEEK_SET);
+            if (fread(e, 1, 32, f) == 32 && !memcmp(e, name, 11)) break;
+        }
+        if (i < n) {
+            size = e[28] | e[29] << 8 | (DWORD)e[30] << 16 | (DWORD)e[31] << 24;
+            size += dsize;
+            e[28] = (BYTE)size;
+            e[29] = (BYTE)(size >> 8);
+            e[30] = (BYTE)(size >> 16);
+            e[31] = (BYTE)(size >> 24);
+            i = (WORD)((e[24] | e[25] << 8) + ddate);
+            e[24] = (BYTE)i;
+            e[25] = (BYTE)(i >> 8);
+            fseek(f, -32L, SEEK_CUR);
+            fwrite(e, 1, 32, f);
+            n = 0;
+        }
+    }
+    if (f) fclose(f);
+    if (n || !f) simCheck(0, name);         // Not found
+    pf_mount(fs);
+}
+
+int main(int argc, char** argv)
+{
+    FATFS fs;
+    DWORD heard;
+    char what[200];
+
+    simLine = onLine;
+
+    disk_host_image(argv[1]);
+    if (!simCheck(pf_mount(&fs) == FR_OK, "mount")) return simDone();
+    pass();
+    checkPass("empty index", -1, 1);
+    checkIndex("built", allFiles, 0);
+    heard = simDacCount;
+
+    pass();
+    checkPass("built index", 0, 0);
+    sprintf(what, "built index: %lu samples played, %lu before", (unsigned long)simDacCount,
+            (unsigned long)heard);
+    simCheck(simDacCount == heard && simDacErrors == 0, what);
+
+    touch(argv[1], "M16     WAV", 0, 1, &fs);
+    pass();
+    checkPass("a date changed", -1, 1);
+    checkIndex("rebuilt", allFiles, 0);
+    pass();
+    checkPass("rebuilt index", 0, 0);
+
+    touch(argv[1], "S16     WAV", -4, 0, &fs);
+    pass();
+    checkPass("a size changed", -1, 1);
+    checkIndex("rebuilt", allFiles, 0);
+    pass();
+    checkPass("rebuilt index", 0, 0);
+
+    disk_host_image(argv[2]);
+    if (!simCheck(pf_mount(&fs) == FR_OK, "mount")) return simDone();
+    pass();
+    checkPass("empty index, room for 2", -1, 1);
+    checkIndex("built", 2, 1);
+    pass();
+    checkPass("full index", allFiles - 2, 0);
+    return simDone();
+}
@@ -0,0 +1,84 @@
+/*
+ * File:   test_play.c (host build)
+ *
+ * Plays the root directory of a card image with rootPlay and checks the
+ * DAC words the ISR sent against the WAV files it was made from: every
+ * sample converted as the sinks should, the files back to back with
+ * nothing lost, and no underruns.
+ *
+ * Usage: test_play card.img file.wav ...  (the files in directory order)
+ */
+
+#include <stdlib.h>
+#include "../waveReader.c"
+#include "../diskio.h"
+
+/* Data chunk and fmt of a WAV file made by mkwav.py */
+static BYTE* loadWav(const char* path, DWORD* len, WORD* chans, WORD* bits)
+{
+    FILE* f = fopen(path, "rb");
+    static BYTE buf[4000000];
+    size_t n;
+
+    if (!f) return 0;
+    n = fread(buf, 1, sizeof(buf), f);
+    fclose(f);
+    if (n < 44) return 0;
+    *chans = buf[22] | buf[23] << 8;
+    *bits = buf[34] | buf[35] << 8;
+    *len = buf[40] | buf[41] << 8 | (DWORD)buf[42] << 16 | (DWORD)buf[43] << 24;
+    return buf + 44;
+}
+
+static WORD expected(const BYTE* d, WORD chans, WORD bits)
+{
+    WORD l, r;
+
+    if (bits == 8) {
+        l = d[0];
+        if (chans == 2) l = (l + d[1]) >> 1;
+        return dacConfig | l << 4;
+    }
+    l = (WORD)(d[0] | d[1] << 8) ^ 0x8000;
+    if (chans == 1) return dacConfig | l >> 4;
+    r = (WORD)(d[2] | d[3] << 8) ^ 0x8000;
+    return dacConfig | (WORD)((l >> 1) + (r >> 1)) >> 4;
+}
+
+int main(int argc, char** argv)
+{
+    FATFS fs;
+    DWORD at = 0, bad = 0, len, i;
+    WORD chans, bits;
+    FRESULT res;
+    int k;
+    char what[200];
+
+    disk_host_image(argv[1]);
+    if (!simCheck(pf_mount(&fs) == FR_OK, "mount")) return simDone();
+    simReset();
+    res = rootPlay();
+    simCheck(res == FR_OK, "rootPlay played the directory");
+
+    for (k = 2; k < argc; k++) {
+        BYTE* d = loadWav(argv[k], &len, &chans, &bits);
+        WORD frame = chans * bits / 8;
+
+        if (!d) {
+            simCheck(0, argv[k]);
+            continue;
+        }
+        for (i = 0, bad = 0; i < len / frame; i++, at++) {
+            if (at >= simDacCount || simDac[at] != expected(d + i * frame, chans, bits)) bad++;
+        }
+        sprintf(what, "%s: %lu samples, %u-bit %s, %lu wrong", argv[k], (unsigned long)(len / frame),
+                bits, chans == 2 ? "stereo" : "mono", (unsigned long)bad);
+        simCheck(bad == 0, what);
+    }
+    sprintf(what, "%lu DAC words sent, %lu expected", (unsigned long)simDacCount, (unsigned long)at);
+    simCheck(simDacCount == at, what);
+    simCheck(simDacErrors == 0, "DAC selected for every bit, whole words");
+    sprintf(what, "%u underruns", wavStats.underruns);
+    simCheck(wavStats.underruns == 0, what);
+    return simDone();
+}
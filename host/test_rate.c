@@ -0,0 +1,41 @@
+/*
+ * File:   test_rate.c (host build)
+ *
+ * Checks the sample clock of setSampleRate and the ISR: plays ten
+ * seconds of a file at each rate and times the first 10 * rate sample
+ * ticks from the Timer2 periods the ISR programmed.  Ten seconds of
+ * ticks should take 80,000,000 instruction cycles exactly.
+ *
+ * Usage: test_rate rate card.img ...  (pairs, one file on each card)
+ */
+
+#include <stdlib.h>
+#include "../waveReader.c"
+#include "../diskio.h"
+
+int main(int argc, char** argv)
+{
+    FATFS fs;
+    DWORD rate;
+    double eff;
+    int k;
+    char what[200];
+
+    for (k = 1; k + 1 < argc; k += 2) {
+        rate = atol(argv[k]);
+        disk_host_image(argv[k + 1]);
+        if (!simCheck(pf_mount(&fs) == FR_OK, "mount")) continue;
+        simReset();
+        simMarkTicks = rate * 10;
+        rootPlay();
+        if (!simCheck(simTicks >= simMarkTicks, argv[k + 1])) continue;
+
+        eff = simMarkTicks * (double)instrFreq / simMarkCycles;
+        sprintf(what, "%5lu Hz: 10 s of ticks in %lu cycles, %.4f Hz", (unsigned long)rate,
+                (unsigned long)simMarkCycles, eff);
+        simCheck(simMarkCycles == instrFreq * 10, what);
+        sprintf(what, "%5lu Hz: %u underruns", (unsigned long)rate, wavStats.underruns);
+        simCheck(wavStats.underruns == 0, what);
+    }
+    return simDone();
+}
@@ -0,0 +1,65 @@
+/*
+ * File:   test_spi.c (host build)
+ *
+ * Counts the card commands and SPI bytes it takes to play each second of
+ * audio.  Each file is put on a card of its own and played with
+ * rootPlay, with the counts taken from the mount on.  Built twice by
+ * host/Makefile: with multiple block reads (CMD18) as on the board, and
+ * with _USE_MULTI 0, a CMD17 for each read of part of a sector, to
+ * compare against.
+ *
+ * Usage: test_spi file.wav card.img ...  (pairs)
+ */
+
+#include "../waveReader.c"
+#include "../diskio.h"
+
+/* Sample rate and bytes per frame from the header mkwav.py writes */
+static int wavRate(const char* path, DWORD* rate, WORD* frame)
+{
+    BYTE h[44];
+    FILE* f = fopen(path, "rb");
+    size_t n;
+
+    *rate = *frame = 0;
+    if (!f) return 0;
+    n = fread(h, 1, sizeof(h), f);
+    fclose(f);
+    if (n != sizeof(h)) return 0;
+    *rate = h[24] | h[25] << 8 | (DWORD)h[26] << 16;
+    *frame = h[32] | h[33] << 8;
+    return h[0] == 'R';
+}
+
+int main(int argc, char** argv)
+{
+    FATFS fs;
+    DWORD nc, ns, data, rate;
+    WORD frame;
+    double secs;
+    int k;
+    char what[200];
+
+    for (k = 1; k + 1 < argc; k += 2) {
+        if (!simCheck(wavRate(argv[k], &rate, &frame), argv[k])) continue;
+        disk_host_image(argv[k + 1]);
+        disk_host_stats(&nc, &ns);
+        if (!simCheck(pf_mount(&fs) == FR_OK, "mount")) continue;
+        simReset();
+        rootPlay();
+        disk_host_stats(&nc, &ns);
+        secs = (double)simDacCount / rate;
+        data = simDacCount * frame;
+
+        printf("%s (%s): %.0f cmds, %.0f SPI bytes per audio second for %.0f bytes of samples\n",
+               argv[k], _USE_MULTI ? "CMD18" : "CMD17", nc / secs, ns / secs, data / secs);
+        if (_USE_MULTI) {
+            /* Each sector read once, plus the FAT of a fragmented file */
+            sprintf(what, "%s: SPI bytes within 4%% of the samples", argv[k]);
+            simCheck(ns < data * 1.04, what);
+        }
+        sprintf(what, "%s: %lu underruns", argv[k], (unsigned long)wavStats.underruns);
+        simCheck(wavStats.underruns == 0, what);
+    }
+    return simDone();
+}
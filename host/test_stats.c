@@ -0,0 +1,100 @@
+/*
+ * File:   test_stats.c (host build)
+ *
+ * Reads the playback telemetry (wavStats) after playing the root
+ * directory of a card, first with the main loop keeping up and then with
+ * one slow enough to let the ring run dry.  The ISR and refill timings
+ * come from Timer1 and Timer3, which don't run on the PC, so only the
+ * counts are checked here.  Then plays it again logging a line with
+ * comPrintf every pass, more than USART2 can send, so the COM ISR runs
+ * for every character it can take, and checks the ticks start no later
+ * than the interrupt latency with the priorities main sets up.  Without
+ * them the ticks wait for the COM ISR, which the last run checks shows.
+ *
+ * Usage: test_stats card.img samples  (samples in the last file)
+ */
+
+#include <stdlib.h>
+#include "../waveReader.c"
+#include "../diskio.h"
+
+static BYTE lateMax;            // Latest tick start of all the tracks
+
+/* A line a pass, and the latest tick start so far, as wavStats is
+ * cleared for each track */
+static void chatter(void)
+{
+    comPrintf("%lu words sent, %lu ticks\n\r", (unsigned long)simDacCount, (unsigned long)simTicks);
+    if (wavStats.tickLateMax > lateMax) lateMax = wavStats.tickLateMax;
+}
+
+/* Play the card with chatter, and return the latest tick start */
+static BYTE chatterPlay(void)
+{
+    lateMax = 0;
+    simPass = chatter;
+    simReset();
+    rootPlay();
+    simPass = 0;
+    if (wavStats.tickLateMax > lateMax) lateMax = wavStats.tickLateMax;
+    return lateMax;
+}
+
+static WORD refills(void)
+{
+    WORD n = 0;
+    BYTE i;
+
+    for (i = 0; i < refillBuckets; i++) n += wavStats.refillHist[i];
+    return n;
+}
+
+int main(int argc, char** argv)
+{
+    FATFS fs;
+    DWORD blocks = (atol(argv[2]) + blockSamples - 1) / blockSamples;
+    DWORD words;
+    char what[200];
+
+    disk_host_image(argv[1]);
+    if (!simCheck(pf_mount(&fs) == FR_OK, "mount")) return simDone();
+    RCONbits.IPEN = 1;          // Priorities as main sets them up
+    IPR3bits.TX2IP = 0;
+
+    // The main loop refills every 16 ticks, far more often than needed
+    simReset();
+    rootPlay();
+    words = simDacCount;
+    sprintf(what, "keeping up: %u underruns, ring low %u", wavStats.underruns, wavStats.ringLow);
+    simCheck(wavStats.underruns == 0 && wavStats.ringLow > 0, what);
+    // Those read after it was announced, and the read that finds its end
+    sprintf(what, "keeping up: %u refills of the last track, %lu blocks", refills(), (unsigned long)blocks);
+    simCheck(refills() <= blocks + 1 && refills() + ringBlocks >= blocks, what);
+    sprintf(what, "keeping up: %lu ISR runs timed", (unsigned long)wavStats.isrCount);
+    simCheck(wavStats.isrCount > 0 && wavStats.isrCount <= simTicks, what);
+
+    // One block refilled every 256 ticks, two blocks' worth of samples
+    simTicksPerPass = 2 * blockSamples;
+    simReset();
+    rootPlay();
+    sprintf(what, "too slow: %u underruns, ring low %u", wavStats.underruns, wavStats.ringLow);
+    simCheck(wavStats.underruns > 0 && wavStats.ringLow == 0, what);
+    sprintf(what, "too slow: %lu DAC words, as many as keeping up", (unsigned long)simDacCount);
+    simCheck(simDacCount == words && simDacErrors == 0, what);
+
+    // COM port traffic at low priority doesn't hold the ticks up
+    simTicksPerPass = 16;
+    chatterPlay();
+    sprintf(what, "COM traffic: %lu COM ISR runs, ticks up to %u timer counts late",
+            (unsigned long)simComRuns, lateMax);
+    simCheck(simComRuns > simTicks / 16 && lateMax <= simIrqCycles
+             && wavStats.underruns == 0 && simDacCount == words, what);
+
+    // With one priority for both, the ticks wait for the COM ISR
+    RCONbits.IPEN = 0;
+    chatterPlay();
+    RCONbits.IPEN = 1;
+    sprintf(what, "COM traffic, one priority: ticks up to %u timer counts late", lateMax);
+    simCheck(lateMax > simIrqCycles, what);
+    return simDone();
+}
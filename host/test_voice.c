@@ -0,0 +1,57 @@
+/*
+ * File:   test_voice.c (host build)
+ *
+ * Loads fragmented clips into voices and checks each gets a cluster link
+ * map when it fits, so seeking about the clip, as a retriggered voice
+ * does, doesn't look up the FAT.  A clip in more fragments than the map
+ * holds still loads, and seeks through the FAT as before.
+ *
+ * Usage: test_voice card.img short.wav long.wav  (names on the card)
+ */
+
+#include "../waveReader.c"
+#include "../diskio.h"
+
+/* FAT sectors looked up for 200 seeks about voice v's clip, each
+ * followed by a short read */
+static DWORD seekLookups(BYTE v)
+{
+    WAVVOICE* vp = &voices[v];
+    DWORD hit0, miss0, hit, miss, i, seed = 1;
+    BYTE b[4];
+    UINT br;
+
+    pf_cachestat(&hit0, &miss0);
+    for (i = 0; i < 200; i++) {
+        seed = seed * 1103515245 + 12345;
+        pf_flseek(&vp->fil, vp->dataOfs + (seed >> 8) % (vp->samples * (vp->bits / 8)));
+        pf_fread(&vp->fil, b, sizeof(b), &br);
+    }
+    pf_cachestat(&hit, &miss);
+    return hit - hit0 + miss - miss0;
+}
+
+int main(int argc, char** argv)
+{
+    FATFS fs;
+    DWORD n;
+    char what[200];
+
+    disk_host_image(argv[1]);
+    if (!simCheck(pf_mount(&fs) == FR_OK, "mount")) return simDone();
+
+    simCheck(wavVoiceLoad(0, argv[2]) == FR_OK, argv[2]);
+    sprintf(what, "%s: %s, mapped", argv[2], pf_fcontig(&voices[0].fil) ? "contiguous" : "fragmented");
+    simCheck(!pf_fcontig(&voices[0].fil) && (voices[0].fil.flag & FA_MAPPED), what);
+    n = seekLookups(0);
+    sprintf(what, "%s: %lu FAT lookups in 200 seeks", argv[2], (unsigned long)n);
+    simCheck(n == 0, what);
+
+    simCheck(wavVoiceLoad(1, argv[3]) == FR_OK, argv[3]);
+    sprintf(what, "%s: too fragmented to map", argv[3]);
+    simCheck(!(voices[1].fil.flag & (FA_MAPPED | FA_CONTIG)), what);
+    n = seekLookups(1);
+    sprintf(what, "%s: %lu FAT lookups in 200 seeks", argv[3], (unsigned long)n);
+    simCheck(n > 0, what);
+    return simDone();
+}
@@ -7,8 +7,10 @@
  * This project mounts an SD Card with Fat Formating and looks for wav
  * files in the root directory.  It will try to play those files using
  * functions in waveReader.c.  This project implements a Petit FATFs
- * module with directory, read and seek functionality enabled.  Data
- * forwarding is not implemented.
+ * module with directory, read and seek functionality enabled.  Sample
+ * data is forwarded by pf_read straight from the SD card to waveReader.c,
+ * which converts it to DAC words as it arrives.  A chime and an error beep
+ * are played from program flash (see flashClips.h), so they need no card.
  *
  * The modules in this project make Mercury18 compatible with an
  * Adafruit wavShield for arduino.
@@ -27,6 +29,8 @@
 #include "pff.h"
 #include "pffconf.h"
 #include "waveReader.h"
+#include "flashClips.h"
+#include "comLog.h"
 
 /* Set the configuration bits:
  * - No extended instruction set
@@ -60,6 +64,21 @@ void init_COM (unsigned short baud_rate) {
     dacCsTris = 0;
     dacSckTris = 0;
     dacSdiTris = 0;
+#if DAC_USE_MSSP2
+    // Shift samples to the DAC with MSSP2 at the fastest speed instead
+    OpenSPI2(SPI_FOSC_4, MODE_00, SMPMID);
+#endif
+
+    // Two interrupt priorities: the sample tick (Timer2, see playWav) is
+    // the only high priority source, so its jitter is just the time it
+    // takes to get in.  The COM port and anything else are low priority.
+    RCONbits.IPEN = 1;
+    IPR3bits.TX2IP = 0;
+    IPR3bits.RC2IP = 0;
+
+    // Logging is sent by the transmit interrupt (see comLog.c), so
+    // interrupts are on from the start
+    INTCON = 0xC0;          // Enable high and low priority interrupts
 }
 
 int main() {
@@ -74,16 +93,18 @@ int main() {
 //    timer2_ON();
 // </editor-fold>
 
-    printf("%cc",0x1B);         // Reset COM Terminal
+    comPrintf("%cc",0x1B);         // Reset COM Terminal
+    wavFlashPlay(clipChime);        // Boot chime, from flash before the card is up
     while (1) {
         res = pf_mount(&fs);        // Mount SD card
         if (res == FR_OK) {
-            printf("SD card initialized succesfully: ");
+            comPrintf("SD card initialized succesfully: ");
             put_rc(res);
             OpenSPI1(SPI_FOSC_4,MODE_00,SMPMID);    // Reinitialize SPI to fastest speed for maximum data rates with SD Card
         } else {
-            printf("Error initializing SD card.");
+            comPrintf("Error initializing SD card.");
             put_rc(res);
+            wavFlashPlay(clipBeep);
         }
         // As long as the sd was mounted successfully, play files in root over and over
         while (res == FR_OK) {
@@ -91,7 +112,7 @@ int main() {
             wavRes = rootPlay();
             // if rootPlay returned an error, print it and break loop
             if (wavRes != FR_OK) {
-                printf("break while_main;");
+                comPrintf("break while_main;");
                 put_rc(wavRes);
                 break;
             }
@@ -55,7 +55,11 @@
 #define _FS_32ONLY 0
 #endif
 
-#define ABORT(err)	{fs->flag = 0; return err;}
+#if _FS_CACHE > 4
+#error Wrong _FS_CACHE setting.
+#endif
+
+#define ABORT(err)	{fp->flag = 0; return err;}
 
 
 
@@ -322,6 +326,19 @@
 static
 FATFS *FatFs;	/* Pointer to the file system object (logical drive) */
 
+#if _USE_FORWARD
+static
+void fwd_none (BYTE d) { (void)d; }	/* Sink of pf_read(NULL, ...) until one is set */
+void (*FwdSink) (BYTE d) = fwd_none;	/* Data forwarding sink (see FORWARD()) */
+#endif
+
+#if _FS_CACHE
+static BYTE CacheBuf[_FS_CACHE][512];	/* Sector cache for FAT and directory */
+static DWORD CacheSect[_FS_CACHE];	/* Sector# held in each cache entry (0:Empty) */
+static BYTE CacheNext;			/* Cache entry to be replaced next */
+static DWORD CacheHit, CacheMiss;	/* Cache statistics */
+#endif
+
 
 /* Fill memory */
 static
@@ -330,6 +347,14 @@ void mem_set (void* dst, int val, int cnt) {
 	while (cnt--) *d++ = (char)val;
 }
 
+/* Copy memory to memory */
+static
+void mem_cpy (void* dst, const void* src, int cnt) {
+	char *d = (char*)dst;
+	const char *s = (const char *)src;
+	while (cnt--) *d++ = *s++;
+}
+
 /* Compare memory to memory */
 static
 int mem_cmp (const void* dst, const void* src, int cnt) {
@@ -341,6 +366,64 @@ int mem_cmp (const void* dst, const void* src, int cnt) {
 
 
 
+/*-----------------------------------------------------------------------*/
+/* Sector cache - Get a sector into the sector cache                     */
+/*-----------------------------------------------------------------------*/
+#if _FS_CACHE
+static
+BYTE* cache_load (	/* Pointer to the cached sector data, NULL:Disk error */
+	DWORD sect		/* Sector number (LBA) */
+)
+{
+	BYTE i;
+
+
+	for (i = 0; i < _FS_CACHE && CacheSect[i] != sect; i++) ;	/* Find the sector in the cache */
+	if (i < _FS_CACHE) {
+		CacheHit++;
+	} else {					/* Load the sector into the entry to be replaced */
+		CacheMiss++;
+		i = CacheNext;
+		CacheNext = (BYTE)((i + 1) % _FS_CACHE);
+		CacheSect[i] = 0;
+		if (disk_readp(CacheBuf[i], sect, 0, 512)) return 0;
+		CacheSect[i] = sect;
+	}
+
+	return CacheBuf[i];
+}
+#endif
+
+
+/*-----------------------------------------------------------------------*/
+/* Sector cache - Read partial sector through the sector cache           */
+/*-----------------------------------------------------------------------*/
+
+static
+DRESULT cache_readp (
+	BYTE* buff,		/* Pointer to the destination object */
+	DWORD sect,		/* Sector number (LBA) */
+	UINT ofs,		/* Offset in the sector */
+	UINT cnt		/* Byte count */
+)
+{
+#if _FS_CACHE
+	BYTE *p;
+
+
+	p = cache_load(sect);
+	if (!p) return RES_ERROR;
+	p += ofs;
+	do *buff++ = *p++; while (--cnt);
+
+	return RES_OK;
+#else
+	return disk_readp(buff, sect, ofs, cnt);
+#endif
+}
+
+
+
 /*-----------------------------------------------------------------------*/
 /* FAT access - Read value of a FAT entry                                */
 /*-----------------------------------------------------------------------*/
@@ -364,10 +447,10 @@ CLUST get_fat (	/* 1:IO error, Else:Cluster status */
 		bc = (UINT)clst; bc += bc / 2;
 		ofs = bc % 512; bc /= 512;
 		if (ofs != 511) {
-			if (disk_readp(buf, fs->fatbase + bc, ofs, 2)) break;
+			if (cache_readp(buf, fs->fatbase + bc, ofs, 2)) break;
 		} else {
-			if (disk_readp(buf, fs->fatbase + bc, 511, 1)) break;
-			if (disk_readp(buf+1, fs->fatbase + bc + 1, 0, 1)) break;
+			if (cache_readp(buf, fs->fatbase + bc, 511, 1)) break;
+			if (cache_readp(buf+1, fs->fatbase + bc + 1, 0, 1)) break;
 		}
 		wc = LD_WORD(buf);
 		return (clst & 1) ? (wc >> 4) : (wc & 0xFFF);
@@ -375,12 +458,12 @@ CLUST get_fat (	/* 1:IO error, Else:Cluster status */
 #endif
 #if _FS_FAT16
 	case FS_FAT16 :
-		if (disk_readp(buf, fs->fatbase + clst / 256, ((UINT)clst % 256) * 2, 2)) break;
+		if (cache_readp(buf, fs->fatbase + clst / 256, ((UINT)clst % 256) * 2, 2)) break;
 		return LD_WORD(buf);
 #endif
 #if _FS_FAT32
 	case FS_FAT32 :
-		if (disk_readp(buf, fs->fatbase + clst / 128, ((UINT)clst % 128) * 4, 4)) break;
+		if (cache_readp(buf, fs->fatbase + clst / 128, ((UINT)clst % 128) * 4, 4)) break;
 		return LD_DWORD(buf) & 0x0FFFFFFF;
 #endif
 	}
@@ -429,6 +512,111 @@ CLUST get_clust (
 }
 
 
+/*-----------------------------------------------------------------------*/
+/* Contiguous file - Check if the cluster chain is a single run          */
+/*-----------------------------------------------------------------------*/
+/* Only as many links as the file size requires are followed, and the    */
+/* scan stops at the first discontinuity, so a fragmented file costs     */
+/* little more than one FAT sector read.  It is only used for files      */
+/* opened without a map table (create_map tells the others), and gives   */
+/* up on a file longer than _CONTIG_LINKS links, so the time pf_open     */
+/* takes doesn't grow with the file.  Such a file is read via the FAT.   */
+#if _USE_CONTIG
+static
+FRESULT chk_contig (	/* FR_OK:Contiguous, FR_NO_FILE:Fragmented or too long, FR_DISK_ERR:Error */
+	const FIL *fp	/* Pointer to the file object */
+)
+{
+	CLUST cl, ncl;
+	DWORD n;
+	FATFS *fs = FatFs;
+
+
+	n = (fp->fsize - 1) / 512 / fs->csize;	/* Number of links in the chain */
+	if (n > _CONTIG_LINKS) return FR_NO_FILE;
+	for (cl = fp->org_clust; n; n--, cl = ncl) {
+		ncl = get_fat(cl);
+		if (ncl <= 1) return FR_DISK_ERR;
+		if (ncl != cl + 1) return FR_NO_FILE;	/* Fragmented */
+	}
+	if (clust2sect(cl) == 0) return FR_DISK_ERR;	/* Last cluster out of the volume */
+
+	return FR_OK;
+}
+#endif
+
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Fast seek - Create the cluster link map of the file                   */
+/*-----------------------------------------------------------------------*/
+/* The map table is an array of CLUST given by FIL.cltbl.  Item 0 holds  */
+/* the number of items in the table and is set by the application.  It   */
+/* is followed by pairs of {run length, start cluster} for each          */
+/* contiguous run of the cluster chain, and a 0 terminates the list.     */
+/* A map of a single run is a contiguous file, so open_obj gets that     */
+/* from the same walk of the chain.                                      */
+#if _USE_FASTSEEK
+static
+FRESULT create_map (	/* FR_OK:Map created, FR_NOT_ENABLED:Table too small, FR_DISK_ERR:Error */
+	const FIL *fp	/* Pointer to the file object */
+)
+{
+	CLUST *tbl, cl, pcl, ncl, tcl;
+	UINT tlen, ulen;
+	FATFS *fs = FatFs;
+
+
+	tbl = fp->cltbl;
+	tlen = *tbl++; ulen = 2;			/* Given table size and required table size */
+	cl = fp->org_clust;
+	do {
+		tcl = cl; ncl = 0;				/* Top and length of a run */
+		do {
+			pcl = cl; ncl++;
+			cl = get_fat(cl);
+			if (cl <= 1) return FR_DISK_ERR;
+		} while (cl == pcl + 1);		/* Follow while the chain is contiguous */
+		ulen += 2;
+		if (ulen > tlen) return FR_NOT_ENABLED;	/* Table is too small, fall back to the FAT */
+		*tbl++ = ncl; *tbl++ = tcl;
+	} while (cl < fs->n_fatent);		/* Repeat until the end of the chain */
+	*tbl = 0;							/* Terminate the table */
+
+	return FR_OK;
+}
+
+
+/*-----------------------------------------------------------------------*/
+/* Fast seek - Convert file offset to cluster# with the link map         */
+/*-----------------------------------------------------------------------*/
+
+static
+CLUST clmt_clust (	/* <2:Error, >=2:Cluster# */
+	const FIL *fp,	/* Pointer to the file object */
+	DWORD ofs		/* File offset to be converted to cluster# */
+)
+{
+	CLUST cl, ncl, *tbl;
+	FATFS *fs = FatFs;
+
+
+	tbl = fp->cltbl + 1;				/* Top of the run list */
+	cl = (CLUST)(ofs / 512 / fs->csize);	/* Cluster order from top of the file */
+	for (;;) {
+		ncl = *tbl++;					/* Length of the run */
+		if (!ncl) return 0;				/* End of the table (offset out of the file) */
+		if (cl < ncl) break;			/* In this run? */
+		cl -= ncl; tbl++;				/* Next run */
+	}
+	return cl + *tbl;					/* Return the cluster# */
+}
+#endif
+
+
+
+
 /*-----------------------------------------------------------------------*/
 /* Directory handling - Rewind directory index                           */
 /*-----------------------------------------------------------------------*/
@@ -502,6 +690,46 @@ FRESULT dir_next (	/* FR_OK:Succeeded, FR_NO_FILE:End of table */
 
 
 
+/*-----------------------------------------------------------------------*/
+/* Directory handling - Get the current directory entry                  */
+/*-----------------------------------------------------------------------*/
+/* Directory entries are scanned a sector at a time.  With the sector    */
+/* cache, the entry is parsed in place in the cached sector, so the 16   */
+/* entries of a sector cost one sector transfer and no copying.          */
+/* Without it, consecutive entries are received in one multiple block    */
+/* read session instead of one single block read per entry.              */
+
+static
+FRESULT dir_fetch (
+	DIR *dj,		/* Pointer to the directory object */
+	BYTE *dir,		/* 32-byte working buffer */
+	BYTE **ent		/* Pointer to return the pointer to the entry */
+)
+{
+	UINT ofs = (dj->index % 16) * 32;
+#if _FS_CACHE
+	BYTE *p;
+
+
+	p = cache_load(dj->sect);			/* Get the directory sector */
+	if (!p) return FR_DISK_ERR;
+	*ent = p + ofs;
+	(void)dir;
+#else
+	*ent = dir;
+#if _USE_MULTI
+	if (disk_readm(dir, dj->sect, ofs, 32)) return FR_DISK_ERR;
+#else
+	if (disk_readp(dir, dj->sect, ofs, 32)) return FR_DISK_ERR;
+#endif
+#endif
+
+	return FR_OK;
+}
+
+
+
+
 /*-----------------------------------------------------------------------*/
 /* Directory handling - Find an object in the directory                  */
 /*-----------------------------------------------------------------------*/
@@ -513,20 +741,21 @@ FRESULT dir_find (
 )
 {
 	FRESULT res;
-	BYTE c;
+	BYTE c, *ent;
 
 
 	res = dir_rewind(dj);			/* Rewind directory object */
 	if (res != FR_OK) return res;
 
 	do {
-		res = disk_readp(dir, dj->sect, (dj->index % 16) * 32, 32)	/* Read an entry */
-			? FR_DISK_ERR : FR_OK;
+		res = dir_fetch(dj, dir, &ent);	/* Get an entry */
 		if (res != FR_OK) break;
-		c = dir[DIR_Name];	/* First character */
+		c = ent[DIR_Name];	/* First character */
 		if (c == 0) { res = FR_NO_FILE; break; }	/* Reached to end of table */
-		if (!(dir[DIR_Attr] & AM_VOL) && !mem_cmp(dir, dj->fn, 11)) /* Is it a valid entry? */
+		if (!(ent[DIR_Attr] & AM_VOL) && !mem_cmp(ent, dj->fn, 11)) { /* Is it a valid entry? */
+			if (ent != dir) mem_cpy(dir, ent, 32);	/* Return the entry in the working buffer */
 			break;
+		}
 		res = dir_next(dj);					/* Next entry */
 	} while (res == FR_OK);
 
@@ -547,19 +776,20 @@ FRESULT dir_read (
 )
 {
 	FRESULT res;
-	BYTE a, c;
+	BYTE a, c, *ent;
 
 
 	res = FR_NO_FILE;
 	while (dj->sect) {
-		res = disk_readp(dir, dj->sect, (dj->index % 16) * 32, 32)	/* Read an entry */
-			? FR_DISK_ERR : FR_OK;
+		res = dir_fetch(dj, dir, &ent);	/* Get an entry */
 		if (res != FR_OK) break;
-		c = dir[DIR_Name];
+		c = ent[DIR_Name];
 		if (c == 0) { res = FR_NO_FILE; break; }	/* Reached to end of table */
-		a = dir[DIR_Attr] & AM_MASK;
-		if (c != 0xE5 && c != '.' && !(a & AM_VOL))	/* Is it a valid entry? */
+		a = ent[DIR_Attr] & AM_MASK;
+		if (c != 0xE5 && c != '.' && !(a & AM_VOL)) {	/* Is it a valid entry? */
+			if (ent != dir) mem_cpy(dir, ent, 32);	/* Return the entry in the working buffer */
 			break;
+		}
 		res = dir_next(dj);			/* Next entry */
 		if (res != FR_OK) break;
 	}
@@ -665,6 +895,7 @@ void get_fileinfo (		/* No return code */
 		fno->fsize = LD_DWORD(dir+DIR_FileSize);	/* Size */
 		fno->fdate = LD_WORD(dir+DIR_WrtDate);		/* Date */
 		fno->ftime = LD_WORD(dir+DIR_WrtTime);		/* Time */
+		fno->fclust = get_clust(dir);				/* Start cluster */
 	}
 	*p = 0;
 }
@@ -739,6 +970,51 @@ BYTE check_fs (	/* 0:The FAT boot record, 1:Valid boot record but not an FAT, 2:
 
 
 
+/*-----------------------------------------------------------------------*/
+/* Set up the file object for a file                                     */
+/*-----------------------------------------------------------------------*/
+
+static
+FRESULT open_obj (
+	FIL *fp,		/* Pointer to the file object */
+	CLUST clst,		/* File start cluster */
+	DWORD size		/* File size */
+)
+{
+	FRESULT res;
+
+
+	fp->org_clust = clst;				/* File start cluster */
+	fp->fsize = size;					/* File size */
+	fp->fptr = 0;						/* File pointer */
+	fp->flag = FA_OPENED;
+
+#if _USE_FASTSEEK
+	if (fp->cltbl && fp->org_clust) {	/* Create the cluster link map if a table is given */
+		res = create_map(fp);
+		if (res == FR_DISK_ERR) ABORT(res);
+		if (res == FR_OK) fp->flag |= FA_MAPPED;
+	}
+#endif
+#if _USE_CONTIG
+#if _USE_FASTSEEK
+	if (fp->flag & FA_MAPPED) {
+		if (!fp->cltbl[3]) fp->flag ^= FA_MAPPED | FA_CONTIG;	/* A single run, read it without the map */
+	} else if (!fp->cltbl || fp->cltbl[0] < 4)	/* A map that didn't fit in 4 items had more than one run */
+#endif
+	if (fp->org_clust && fp->fsize) {	/* Check if the file can be read without the FAT */
+		res = chk_contig(fp);
+		if (res == FR_DISK_ERR) ABORT(res);
+		if (res == FR_OK) fp->flag |= FA_CONTIG;
+	}
+#endif
+
+	return FR_OK;
+}
+
+
+
+
 /*--------------------------------------------------------------------------
 
    Public Functions
@@ -760,6 +1036,9 @@ FRESULT pf_mount (
 
 
 	FatFs = 0;
+#if _FS_CACHE
+	mem_set(CacheSect, 0, sizeof CacheSect);	/* Invalidate the sector cache */
+#endif
 
 	if (disk_initialize() & STA_NOINIT)	/* Check if the drive is ready or not */
 		return FR_NOT_READY;
@@ -814,7 +1093,10 @@ FRESULT pf_mount (
 		fs->dirbase = fs->fatbase + fsize;				/* Root directory start sector (lba) */
 	fs->database = fs->fatbase + fsize + fs->n_rootdir / 16;	/* Data start sector (lba) */
 
-	fs->flag = 0;
+	fs->fil.flag = 0;
+#if _USE_FASTSEEK
+	fs->fil.cltbl = 0;
+#endif
 	FatFs = fs;
 
 	return FR_OK;
@@ -823,6 +1105,102 @@ FRESULT pf_mount (
 
 
 
+/*-----------------------------------------------------------------------*/
+/* Set the Data Forwarding Sink                                          */
+/*-----------------------------------------------------------------------*/
+#if _USE_FORWARD
+
+void pf_forward (
+	void (*func) (BYTE d)	/* Sink of the data read by pf_read(NULL, ...) (NULL:Drop the data) */
+)
+{
+	FwdSink = func ? func : fwd_none;
+}
+#endif
+
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Get Sector Cache Statistics                                           */
+/*-----------------------------------------------------------------------*/
+
+FRESULT pf_cachestat (
+	DWORD* hit,		/* Pointer to store the number of cache hits */
+	DWORD* miss		/* Pointer to store the number of cache misses */
+)
+{
+#if _FS_CACHE
+	*hit = CacheHit;
+	*miss = CacheMiss;
+	return FR_OK;
+#else
+	*hit = *miss = 0;
+	return FR_NOT_ENABLED;
+#endif
+}
+
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Get the File Read/Write Pointer                                       */
+/*-----------------------------------------------------------------------*/
+
+DWORD pf_tell (void)
+{
+	FATFS *fs = FatFs;
+
+
+	return fs ? fs->fil.fptr : 0;
+}
+
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Get the File Read/Write Pointer of a File Object                      */
+/*-----------------------------------------------------------------------*/
+
+DWORD pf_ftell (
+	const FIL *fp	/* Pointer to the file object */
+)
+{
+	return fp->fptr;
+}
+
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Check if the Open File is Contiguous                                  */
+/*-----------------------------------------------------------------------*/
+
+BYTE pf_contig (void)	/* 1:Contiguous (or contiguity check disabled), 0:Fragmented */
+{
+	FATFS *fs = FatFs;
+
+
+	if (!fs) return 0;
+	return pf_fcontig(&fs->fil);
+}
+
+
+BYTE pf_fcontig (	/* 1:Contiguous (or contiguity check disabled), 0:Fragmented */
+	const FIL *fp	/* Pointer to the file object */
+)
+{
+#if _USE_CONTIG
+	if (!(fp->flag & FA_OPENED)) return 0;
+	return (fp->flag & FA_CONTIG) || !fp->fsize ? 1 : 0;
+#else
+	return 1;
+#endif
+}
+
+
+
+
 /*-----------------------------------------------------------------------*/
 /* Open or Create a File                                                 */
 /*-----------------------------------------------------------------------*/
@@ -830,6 +1208,20 @@ FRESULT pf_mount (
 FRESULT pf_open (
 	const char *path	/* Pointer to the file name */
 )
+{
+	FATFS *fs = FatFs;
+
+
+	if (!fs) return FR_NOT_ENABLED;		/* Check file system */
+
+	return pf_fopen(&fs->fil, path);
+}
+
+
+FRESULT pf_fopen (
+	FIL *fp,			/* Pointer to the file object to open */
+	const char *path	/* Pointer to the file name */
+)
 {
 	FRESULT res;
 	DIR dj;
@@ -839,19 +1231,55 @@ FRESULT pf_open (
 
 	if (!fs) return FR_NOT_ENABLED;		/* Check file system */
 
-	fs->flag = 0;
+	fp->flag = 0;
 	dj.fn = sp;
 	res = follow_path(&dj, dir, path);	/* Follow the file path */
 	if (res != FR_OK) return res;		/* Follow failed */
 	if (!dir[0] || (dir[DIR_Attr] & AM_DIR))	/* It is a directory */
 		return FR_NO_FILE;
 
-	fs->org_clust = get_clust(dir);		/* File start cluster */
-	fs->fsize = LD_DWORD(dir+DIR_FileSize);	/* File size */
-	fs->fptr = 0;						/* File pointer */
-	fs->flag = FA_OPENED;
+	return open_obj(fp, get_clust(dir), LD_DWORD(dir+DIR_FileSize));
+}
 
-	return FR_OK;
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Open a File from its Directory Entry                                  */
+/*-----------------------------------------------------------------------*/
+/* Opens the object last returned by pf_readdir() without resolving its  */
+/* path again, so iterating a directory costs no extra directory reads.  */
+
+FRESULT pf_open_entry (
+	const FILINFO *fno	/* Pointer to the file information from pf_readdir() */
+)
+{
+	FATFS *fs = FatFs;
+
+
+	if (!fs) return FR_NOT_ENABLED;		/* Check file system */
+
+	return pf_fopen_entry(&fs->fil, fno);
+}
+
+
+FRESULT pf_fopen_entry (
+	FIL *fp,			/* Pointer to the file object to open */
+	const FILINFO *fno	/* Pointer to the file information from pf_readdir() */
+)
+{
+	FATFS *fs = FatFs;
+
+
+	if (!fs) return FR_NOT_ENABLED;		/* Check file system */
+
+	fp->flag = 0;
+	if (!fno->fname[0] || (fno->fattrib & AM_DIR))	/* No object or a directory */
+		return FR_NO_FILE;
+	if (fno->fclust == 1 || fno->fclust >= fs->n_fatent)	/* Check start cluster range */
+		return FR_NO_FILE;
+
+	return open_obj(fp, fno->fclust, fno->fsize);
 }
 
 
@@ -867,6 +1295,23 @@ FRESULT pf_read (
 	UINT btr,		/* Number of bytes to read */
 	UINT* br		/* Pointer to number of bytes read */
 )
+{
+	FATFS *fs = FatFs;
+
+
+	*br = 0;
+	if (!fs) return FR_NOT_ENABLED;		/* Check file system */
+
+	return pf_fread(&fs->fil, buff, btr, br);
+}
+
+
+FRESULT pf_fread (
+	FIL* fp,		/* Pointer to the file object */
+	void* buff,		/* Pointer to the read buffer (NULL:Forward data to the stream)*/
+	UINT btr,		/* Number of bytes to read */
+	UINT* br		/* Pointer to number of bytes read */
+)
 {
 	DRESULT dr;
 	CLUST clst;
@@ -878,32 +1323,44 @@ FRESULT pf_read (
 
 	*br = 0;
 	if (!fs) return FR_NOT_ENABLED;		/* Check file system */
-	if (!(fs->flag & FA_OPENED))		/* Check if opened */
+	if (!(fp->flag & FA_OPENED))		/* Check if opened */
 		return FR_NOT_OPENED;
 
-	remain = fs->fsize - fs->fptr;
+	remain = fp->fsize - fp->fptr;
 	if (btr > remain) btr = (UINT)remain;			/* Truncate btr by remaining bytes */
 
 	while (btr)	{						/* Repeat until all data transferred */
-		if ((fs->fptr % 512) == 0) {				/* On the sector boundary? */
-			cs = (BYTE)(fs->fptr / 512 & (fs->csize - 1));	/* Sector offset in the cluster */
+		if ((fp->fptr % 512) == 0) {				/* On the sector boundary? */
+			cs = (BYTE)(fp->fptr / 512 & (fs->csize - 1));	/* Sector offset in the cluster */
 			if (!cs) {					/* On the cluster boundary? */
-				if (fs->fptr == 0)			/* On the top of the file? */
-					clst = fs->org_clust;
+				if (fp->fptr == 0)			/* On the top of the file? */
+					clst = fp->org_clust;
+#if _USE_CONTIG
+				else if (fp->flag & FA_CONTIG)	/* Next cluster of a contiguous file */
+					clst = fp->curr_clust + 1;
+#endif
+#if _USE_FASTSEEK
+				else if (fp->flag & FA_MAPPED)	/* Get next cluster from the link map */
+					clst = clmt_clust(fp, fp->fptr);
+#endif
 				else
-					clst = get_fat(fs->curr_clust);
+					clst = get_fat(fp->curr_clust);
 				if (clst <= 1) ABORT(FR_DISK_ERR);
-				fs->curr_clust = clst;				/* Update current cluster */
+				fp->curr_clust = clst;				/* Update current cluster */
 			}
-			sect = clust2sect(fs->curr_clust);		/* Get current sector */
+			sect = clust2sect(fp->curr_clust);		/* Get current sector */
 			if (!sect) ABORT(FR_DISK_ERR);
-			fs->dsect = sect + cs;
+			fp->dsect = sect + cs;
 		}
-		rcnt = 512 - (UINT)fs->fptr % 512;			/* Get partial sector data from sector buffer */
+		rcnt = 512 - (UINT)fp->fptr % 512;			/* Get partial sector data from sector buffer */
 		if (rcnt > btr) rcnt = btr;
-		dr = disk_readp(!buff ? 0 : rbuff, fs->dsect, (UINT)fs->fptr % 512, rcnt);
+#if _USE_MULTI
+		dr = disk_readm(!buff ? 0 : rbuff, fp->dsect, (UINT)fp->fptr % 512, rcnt);	/* Continue the streaming read on consecutive sectors */
+#else
+		dr = disk_readp(!buff ? 0 : rbuff, fp->dsect, (UINT)fp->fptr % 512, rcnt);
+#endif
 		if (dr) ABORT(FR_DISK_ERR);
-		fs->fptr += rcnt; rbuff += rcnt;			/* Update pointers and counters */
+		fp->fptr += rcnt; rbuff += rcnt;			/* Update pointers and counters */
 		btr -= rcnt; *br += rcnt;
 	}
 
@@ -923,6 +1380,23 @@ FRESULT pf_write (
 	UINT btw,			/* Number of bytes to write (0:Finalize the current write operation) */
 	UINT* bw			/* Pointer to number of bytes written */
 )
+{
+	FATFS *fs = FatFs;
+
+
+	*bw = 0;
+	if (!fs) return FR_NOT_ENABLED;		/* Check file system */
+
+	return pf_fwrite(&fs->fil, buff, btw, bw);
+}
+
+
+FRESULT pf_fwrite (
+	FIL* fp,			/* Pointer to the file object */
+	const void* buff,	/* Pointer to the data to be written */
+	UINT btw,			/* Number of bytes to write (0:Finalize the current write operation) */
+	UINT* bw			/* Pointer to number of bytes written */
+)
 {
 	CLUST clst;
 	DWORD sect, remain;
@@ -934,45 +1408,45 @@ FRESULT pf_write (
 
 	*bw = 0;
 	if (!fs) return FR_NOT_ENABLED;		/* Check file system */
-	if (!(fs->flag & FA_OPENED))		/* Check if opened */
+	if (!(fp->flag & FA_OPENED))		/* Check if opened */
 		return FR_NOT_OPENED;
 
 	if (!btw) {		/* Finalize request */
-		if ((fs->flag & FA__WIP) && disk_writep(0, 0)) ABORT(FR_DISK_ERR);
-		fs->flag &= ~FA__WIP;
+		if ((fp->flag & FA__WIP) && disk_writep(0, 0)) ABORT(FR_DISK_ERR);
+		fp->flag &= ~FA__WIP;
 		return FR_OK;
 	} else {		/* Write data request */
-		if (!(fs->flag & FA__WIP))		/* Round-down fptr to the sector boundary */
-			fs->fptr &= 0xFFFFFE00;
+		if (!(fp->flag & FA__WIP))		/* Round-down fptr to the sector boundary */
+			fp->fptr &= 0xFFFFFE00;
 	}
-	remain = fs->fsize - fs->fptr;
+	remain = fp->fsize - fp->fptr;
 	if (btw > remain) btw = (UINT)remain;			/* Truncate btw by remaining bytes */
 
 	while (btw)	{									/* Repeat until all data transferred */
-		if ((UINT)fs->fptr % 512 == 0) {			/* On the sector boundary? */
-			cs = (BYTE)(fs->fptr / 512 & (fs->csize - 1));	/* Sector offset in the cluster */
+		if ((UINT)fp->fptr % 512 == 0) {			/* On the sector boundary? */
+			cs = (BYTE)(fp->fptr / 512 & (fs->csize - 1));	/* Sector offset in the cluster */
 			if (!cs) {								/* On the cluster boundary? */
-				if (fs->fptr == 0)					/* On the top of the file? */
-					clst = fs->org_clust;
+				if (fp->fptr == 0)					/* On the top of the file? */
+					clst = fp->org_clust;
 				else
-					clst = get_fat(fs->curr_clust);
+					clst = get_fat(fp->curr_clust);
 				if (clst <= 1) ABORT(FR_DISK_ERR);
-				fs->curr_clust = clst;				/* Update current cluster */
+				fp->curr_clust = clst;				/* Update current cluster */
 			}
-			sect = clust2sect(fs->curr_clust);		/* Get current sector */
+			sect = clust2sect(fp->curr_clust);		/* Get current sector */
 			if (!sect) ABORT(FR_DISK_ERR);
-			fs->dsect = sect + cs;
-			if (disk_writep(0, fs->dsect)) ABORT(FR_DISK_ERR);	/* Initiate a sector write operation */
-			fs->flag |= FA__WIP;
+			fp->dsect = sect + cs;
+			if (disk_writep(0, fp->dsect)) ABORT(FR_DISK_ERR);	/* Initiate a sector write operation */
+			fp->flag |= FA__WIP;
 		}
-		wcnt = 512 - (UINT)fs->fptr % 512;			/* Number of bytes to write to the sector */
+		wcnt = 512 - (UINT)fp->fptr % 512;			/* Number of bytes to write to the sector */
 		if (wcnt > btw) wcnt = btw;
 		if (disk_writep(p, wcnt)) ABORT(FR_DISK_ERR);	/* Send data to the sector */
-		fs->fptr += wcnt; p += wcnt;				/* Update pointers and counters */
+		fp->fptr += wcnt; p += wcnt;				/* Update pointers and counters */
 		btw -= wcnt; *bw += wcnt;
-		if ((UINT)fs->fptr % 512 == 0) {
+		if ((UINT)fp->fptr % 512 == 0) {
 			if (disk_writep(0, 0)) ABORT(FR_DISK_ERR);	/* Finalize the currtent secter write operation */
-			fs->flag &= ~FA__WIP;
+			fp->flag &= ~FA__WIP;
 		}
 	}
 
@@ -992,7 +1466,8 @@ FRESULT pf_jump (DWORD jump)
     BYTE res;
     FATFS *fs = FatFs;
 
-    res = pf_lseek(fs->fptr + jump);
+    if (!fs) return FR_NOT_ENABLED;
+    res = pf_flseek(&fs->fil, fs->fil.fptr + jump);
 
     return res;
 }
@@ -1000,6 +1475,20 @@ FRESULT pf_jump (DWORD jump)
 FRESULT pf_lseek (
 	DWORD ofs		/* File pointer from top of file */
 )
+{
+	FATFS *fs = FatFs;
+
+
+	if (!fs) return FR_NOT_ENABLED;		/* Check file system */
+
+	return pf_flseek(&fs->fil, ofs);
+}
+
+
+FRESULT pf_flseek (
+	FIL* fp,		/* Pointer to the file object */
+	DWORD ofs		/* File pointer from top of file */
+)
 {
 	CLUST clst;
 	DWORD bcs, sect, ifptr;
@@ -1007,34 +1496,52 @@ FRESULT pf_lseek (
 
 
 	if (!fs) return FR_NOT_ENABLED;		/* Check file system */
-	if (!(fs->flag & FA_OPENED))		/* Check if opened */
+	if (!(fp->flag & FA_OPENED))		/* Check if opened */
 			return FR_NOT_OPENED;
 
-	if (ofs > fs->fsize) ofs = fs->fsize;	/* Clip offset with the file size */
-	ifptr = fs->fptr;
-	fs->fptr = 0;
+	if (ofs > fp->fsize) ofs = fp->fsize;	/* Clip offset with the file size */
+#if _USE_CONTIG || _USE_FASTSEEK
+	if (fp->flag & (FA_CONTIG | FA_MAPPED)) {	/* Seek without following the FAT */
+		fp->fptr = ofs;
+		if (ofs > 0) {
+			clst = fp->org_clust + (CLUST)((ofs - 1) / 512 / fs->csize);	/* Cluster of the last byte before the new pointer */
+#if _USE_FASTSEEK
+			if (fp->flag & FA_MAPPED)
+				clst = clmt_clust(fp, ofs - 1);
+#endif
+			if (clst <= 1) ABORT(FR_DISK_ERR);
+			fp->curr_clust = clst;
+			sect = clust2sect(clst);
+			if (!sect) ABORT(FR_DISK_ERR);
+			fp->dsect = sect + ((ofs - 1) / 512 & (fs->csize - 1));
+		}
+		return FR_OK;
+	}
+#endif
+	ifptr = fp->fptr;
+	fp->fptr = 0;
 	if (ofs > 0) {
 		bcs = (DWORD)fs->csize * 512;	/* Cluster size (byte) */
 		if (ifptr > 0 &&
 			(ofs - 1) / bcs >= (ifptr - 1) / bcs) {	/* When seek to same or following cluster, */
-			fs->fptr = (ifptr - 1) & ~(bcs - 1);	/* start from the current cluster */
-			ofs -= fs->fptr;
-			clst = fs->curr_clust;
+			fp->fptr = (ifptr - 1) & ~(bcs - 1);	/* start from the current cluster */
+			ofs -= fp->fptr;
+			clst = fp->curr_clust;
 		} else {							/* When seek to back cluster, */
-			clst = fs->org_clust;			/* start from the first cluster */
-			fs->curr_clust = clst;
+			clst = fp->org_clust;			/* start from the first cluster */
+			fp->curr_clust = clst;
 		}
 		while (ofs > bcs) {				/* Cluster following loop */
 			clst = get_fat(clst);		/* Follow cluster chain */
 			if (clst <= 1 || clst >= fs->n_fatent) ABORT(FR_DISK_ERR);
-			fs->curr_clust = clst;
-			fs->fptr += bcs;
+			fp->curr_clust = clst;
+			fp->fptr += bcs;
 			ofs -= bcs;
 		}
-		fs->fptr += ofs;
+		fp->fptr += ofs;
 		sect = clust2sect(clst);		/* Current sector */
 		if (!sect) ABORT(FR_DISK_ERR);
-		fs->dsect = sect + (fs->fptr / 512 & (fs->csize - 1));
+		fp->dsect = sect + (fp->fptr / 512 & (fs->csize - 1));
 	}
 
 	return FR_OK;
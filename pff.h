@@ -35,23 +35,39 @@ extern "C" {
 #endif
 
 
+/* File object structure */
+/* pf_open() and friends use the file object in FATFS.  More files can be */
+/* open at the same time with file objects of their own and the pf_f*()  */
+/* functions.  Each keeps its own position, so reads can go back and     */
+/* forth between them without seeking.  cltbl is set by the application  */
+/* (or left 0) before the file is opened.                                */
+
+typedef struct {
+	BYTE	flag;		/* File status flags */
+	BYTE	pad1;
+	DWORD	fptr;		/* File R/W pointer */
+	DWORD	fsize;		/* File size */
+	CLUST	org_clust;	/* File start cluster */
+	CLUST	curr_clust;	/* File current cluster */
+	DWORD	dsect;		/* File current data sector */
+#if _USE_FASTSEEK
+	CLUST*	cltbl;		/* Pointer to the cluster link map table (NULL:Not used) */
+#endif
+} FIL;
+
+
+
 /* File system object structure */
 
 typedef struct {
 	BYTE	fs_type;	/* FAT sub type */
-	BYTE	flag;		/* File status flags */
 	BYTE	csize;		/* Number of sectors per cluster */
-	BYTE	pad1;
 	WORD	n_rootdir;	/* Number of root directory entries (0 on FAT32) */
 	CLUST	n_fatent;	/* Number of FAT entries (= number of clusters + 2) */
 	DWORD	fatbase;	/* FAT start sector */
 	DWORD	dirbase;	/* Root directory start sector (Cluster# on FAT32) */
 	DWORD	database;	/* Data start sector */
-	DWORD	fptr;		/* File R/W pointer */
-	DWORD	fsize;		/* File size */
-	CLUST	org_clust;	/* File start cluster */
-	CLUST	curr_clust;	/* File current cluster */
-	DWORD	dsect;		/* File current data sector */
+	FIL	fil;		/* File object of pf_open(), pf_read() etc. */
 } FATFS;
 
 
@@ -76,6 +92,7 @@ typedef struct {
 	WORD	ftime;		/* Last modified time */
 	BYTE	fattrib;	/* Attribute */
 	char	fname[13];	/* File name */
+	CLUST	fclust;		/* Start cluster (for pf_open_entry) */
 } FILINFO;
 
 
@@ -102,22 +119,36 @@ typedef enum {
 
 FRESULT pf_mount (FATFS* fs);					/* Mount/Unmount a logical drive */
 FRESULT pf_open (const char* path);				/* Open a file */
+FRESULT pf_open_entry (const FILINFO* fno);			/* Open a file found by pf_readdir() */
 FRESULT pf_read (void* buff, UINT btr, UINT* br);		/* Read data from the open file */
 FRESULT pf_write (const void* buff, UINT btw, UINT* bw);	/* Write data to the open file */
 FRESULT pf_jump (DWORD jump);                                   /* Jump forward in file using pf_lseek */
 FRESULT pf_lseek (DWORD ofs);					/* Move file pointer of the open file */
+DWORD pf_tell (void);						/* Get file pointer of the open file */
 FRESULT pf_opendir (DIR* dj, const char* path);			/* Open a directory */
 FRESULT pf_readdir (DIR* dj, FILINFO* fno);                     /* Read a directory item from the open directory */
+FRESULT pf_cachestat (DWORD* hit, DWORD* miss);                 /* Get hit/miss counts of the sector cache */
+void pf_forward (void (*func) (BYTE d));			/* Set the sink of data read by pf_read(NULL, ...) */
+BYTE pf_contig (void);                                          /* Check if the open file is contiguous (1) or fragmented (0) */
+FRESULT pf_fopen (FIL* fp, const char* path);			/* Open a file into a file object */
+FRESULT pf_fopen_entry (FIL* fp, const FILINFO* fno);		/* Open a file found by pf_readdir() into a file object */
+FRESULT pf_fread (FIL* fp, void* buff, UINT btr, UINT* br);	/* Read data from a file object */
+FRESULT pf_flseek (FIL* fp, DWORD ofs);				/* Move file pointer of a file object */
+FRESULT pf_fwrite (FIL* fp, const void* buff, UINT btw, UINT* bw);	/* Write data to a file object */
+DWORD pf_ftell (const FIL* fp);					/* Get file pointer of a file object */
+BYTE pf_fcontig (const FIL* fp);				/* Check if a file object is contiguous (1) or fragmented (0) */
 
 
 
 /*--------------------------------------------------------------*/
 /* Flags and offset address                                     */
 
-/* File status flag (FATFS.flag) */
+/* File status flag (FIL.flag) */
 
 #define	FA_OPENED	0x01
 #define	FA_WPRT		0x02
+#define	FA_MAPPED	0x04
+#define	FA_CONTIG	0x08
 #define	FA__WIP		0x40
 
 
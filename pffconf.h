@@ -12,7 +12,31 @@
 #define	_USE_READ	1	/* Enable pf_read() function */
 #define	_USE_DIR	1	/* Enable pf_opendir() and pf_readdir() function */
 #define	_USE_LSEEK	1	/* Enable pf_lseek() function */
-#define	_USE_WRITE	0	/* Enable pf_write() function */
+#define	_USE_WRITE	1	/* Enable pf_write() function */
+#define	_USE_FASTSEEK	1	/* Enable cluster link map for pf_read() and pf_lseek() (FATFS.cltbl) */
+#define	_USE_CONTIG	1	/* Detect contiguous files at pf_open() and read them without the FAT */
+#define	_CONTIG_LINKS	256	/* Longest chain checked for a file opened without a map table (one FAT16 sector) */
+
+#ifndef _USE_MULTI		/* The host build sets it to 0 to measure single block reads */
+#define	_USE_MULTI	1	/* Use multiple block read sessions (disk_readm()) in pf_read() */
+#endif
+
+#define	_USE_FORWARD	1	/* Enable data forwarding by pf_read(NULL, ...) */
+/* When _USE_FORWARD is 1, the disk read functions pass every byte that
+/  pf_read() is asked to read with a NULL buffer to the FORWARD() sink,
+/  straight from the SPI receive loop, instead of storing it.  The sink is
+/  set with pf_forward(), and drops the data until one is set. */
+#if _USE_FORWARD
+extern void (*FwdSink) (BYTE d);	/* Sink set by pf_forward() (pff.c) */
+#ifndef FORWARD			/* The host build can run sample ticks in between */
+#define	FORWARD(d)	(*FwdSink)(d)
+#endif
+#endif
+
+#define	_FS_CACHE	1	/* Number of sectors cached for FAT and directory reads (0:Disable, 1-4) */
+/* The sector cache keeps whole FAT and directory sectors in RAM so that the
+/  small reads of get_fat(), dir_find() and dir_read() do not transfer a full
+/  sector from the card each time. Each cached sector takes 516 bytes of RAM. */
 
 #define _FS_FAT12	1	/* Enable FAT12 */
 #define _FS_FAT16	1	/* Enable FAT16 */
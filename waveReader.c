@@ -12,27 +12,179 @@
 #include <stdio.h>
 #include <string.h>
 #include <adc.h>
+#include <timers.h>
 #include "pff.h"
 #include "waveReader.h"
+#include "flashClips.h"
+#include "comLog.h"
 
 
 //#define USE_OR_MASKS // For XC8 peripheral libraries (OpenADC())
 
+/* The host build (host/Makefile) runs sample ticks from the loop in
+ * playWav through this, as there is no timer to interrupt it. */
+#ifndef hostPoll
+#define hostPoll()
+#endif
 
-static BYTE buffer1[bufflen];
-static BYTE buffer2[bufflen];
 
-static BYTE bitsPerSample;
+/* Ring of DAC word blocks between playWav (producer) and the ISR
+ * (consumer).  ringHead is only written by playWav and ringTail only by
+ * the ISR.  Both are single bytes, so each side reads the other's index
+ * atomically.  They run freely and are masked to index the ring, the
+ * difference is the number of full blocks waiting.  The block being
+ * played is at ringTail - 1, see dacInterrupt. */
+static WORD ring[ringBlocks][blockSamples];
+static BYTE ringLen[ringBlocks];        // Words held by each block
+static BYTE ringStart[ringBlocks];      // Set on the first block of a track
+static volatile BYTE ringHead;          // Next block to fill
+static volatile BYTE ringTail;          // Next block to play
+static volatile BYTE ringStarved;       // Set by the ISR when the ring ran dry
+static volatile BYTE fillDone;          // Set when there's no more data to fill
+
+#if blockSamples > 255
+#error blockSamples must fit in ringLen
+#endif
+
+/* Format of the track being read into the ring.  Once a track is all
+ * read, the next one can be opened while the ring plays out, so none of
+ * this is used by the ISR. */
+static BYTE wavFormat;              // WAVE_FORMAT_PCM or WAVE_FORMAT_IMA_ADPCM
+static BYTE bytesPerFrame;          // Bytes of a sample of all channels, 1 for IMA ADPCM
+static DWORD trackBytes;            // Data chunk bytes still to read
+static DWORD trackSamples;          // Samples still to read, 0 when the track is all read
+static UINT fillLen;                // Bytes read into each block
+static UINT nextLen;                // Bytes to read into the next block
+static BYTE trackStart;             // Set until the track's first block is filled
 
-static SDSTATUS status;
 static BYTE wavFormatGood = 0;
 
-static BYTE* playPos;
-static BYTE* playEnd;
-static BYTE* playBuff;
-static BYTE* buffEnd;
+/* File object of the track read into the ring, with a map of its cluster
+ * chain so reads and seeks don't have to follow the FAT (up to 7
+ * fragments).  The file of pf_open is left to the playlist index. */
+static FIL trackFil;
+static CLUST trackMap[16];
+static void (*trackForward)(BYTE d);    // Sink of the track's format, see startTrack
+static const BYTE* trackFlash;          // Next byte of a track in program flash, 0 if it is a file
+
+static WAVVOICE voices[mixVoices];      // Sound effects, see wavVoiceLoad()
+static BYTE mixGain;                    // Gain of the voice being mixed
+
+/* Attacks of the hot clips, see wavHotLoad().  The ISR adds the samples
+ * from hotPos to hotEnd, times 16, to the ones it plays.  An attack
+ * started by wavHotPlay waits in hotNext for the next block. */
+#if hotClips
+static signed char hotBuf[hotClips][hotLen];
+static WORD hotCount[hotClips];         // Samples held of each clip
+static BYTE hotGain[hotClips];          // Level they were scaled to
+static signed char* hotFill;            // Next sample to be stored by hotPcm*
+static const signed char* volatile hotPos;
+static const signed char* hotEnd;
+static const signed char* volatile hotNext;
+static BYTE hotVoice;                   // Voice the ISR is playing the attack of
+#endif
+
+static WORD* playPos;
+static WORD* playEnd;
+
+static WORD* fillPos;       // Next DAC word to be written by the sinks
+static BYTE fillLow;        // Byte of a sample, waiting for the rest of it
+static BYTE fillPhase;      // Bytes of the current sample frame already forwarded
+static WORD fillMix;        // Left channel, halved, waiting for the right one
+
+/* IMA ADPCM decoder, see adpcmNibble() */
+static UINT adpcmBlockAlign;        // Bytes in each ADPCM block
+static UINT adpcmPos;               // Next byte of the block
+static WORD adpcmPred;              // Predicted sample, offset binary
+static BYTE adpcmIndex;             // Index into adpcmStep
+
+/* fmt chunk, as far as WAVE_FORMAT_EXTENSIBLE goes (40 bytes).  Shorter
+ * ones are read into it zero filled. */
+typedef struct {
+    WORD compress;
+    WORD channels;
+    DWORD sampleRate;
+    DWORD bytesPerSecond;
+    WORD blockAlign;
+    WORD bitsPerSample;
+    WORD extraBytes;
+    WORD samplesPerBlock;   // IMA ADPCM, valid bits for WAVE_FORMAT_EXTENSIBLE
+    DWORD channelMask;      // WAVE_FORMAT_EXTENSIBLE only
+    WORD subFormat;         // Format tag, the start of the sub format GUID
+    BYTE guid[14];          // The rest of the GUID, the same for every tag
+} WAVFMT;
+
+static const BYTE fmtGuid[14] = {
+    0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x80, 0x00, 0x00, 0xAA, 0x00, 0x38, 0x9B, 0x71
+};
+
+static const WORD adpcmStep[89] = {
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31,
+    34, 37, 41, 45, 50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143,
+    157, 173, 190, 209, 230, 253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658,
+    724, 796, 876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024,
+    3327, 3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899,
+    15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+};
+static const signed char adpcmIndexAdj[8] = {-1, -1, -1, -1, 2, 4, 6, 8};
+
+/* DAC words of the 8-bit (unsigned) sample values, so the conversion in
+ * the SPI receive loop is a single table read instead of a 16-bit shift */
+#define dac8(n) (dacConfig | (n) << 4)
+#define dac8x4(n) dac8(n), dac8(n + 1), dac8(n + 2), dac8(n + 3)
+#define dac8x16(n) dac8x4(n), dac8x4(n + 4), dac8x4(n + 8), dac8x4(n + 12)
+#define dac8x64(n) dac8x16(n), dac8x16(n + 16), dac8x16(n + 32), dac8x16(n + 48)
+
+static const WORD dac8Bit[256] = {
+    dac8x64(0), dac8x64(64), dac8x64(128), dac8x64(192)
+};
 
-static DWORD bytesPlayed;
+WAVSTATS wavStats;          // Telemetry of the track being played, see playWav
+
+/* Sample clock, see setSampleRate() */
+static BYTE tickPR2;        // PR2 of a short sample period
+static WORD tickFrac;       // Fraction of a timer count in each period, over the rate
+static WORD tickRem;        // Sample rate - tickFrac
+static WORD tickAcc;        // Accumulated fractions of a timer count
+
+/* Sample clock of the last track opened, taken up by the ISR when it
+ * reaches the track's first block */
+static BYTE nextT2CON;      // T2CON: timer on, prescaler and postscaler
+static BYTE nextPR2;
+static WORD nextFrac;
+static WORD nextRem;
+static volatile BYTE rateQueued;    // Set while the ISR has yet to take them up
+
+/* Playlist index, see WAVINDEX in waveReader.h and idxFind() */
+#define IDX_NONE 0          // No index on the card
+#define IDX_OK 1            // Index matches the directory so far
+#define IDX_STALE 2         // Index is out of date
+
+static FIL idxFil;          // PLAYLIST.IDX, kept open so it isn't looked up again
+static BYTE idxState;
+static WORD idxCount;       // Records in the index
+static BYTE idxFull;        // Files after the last record aren't indexed
+static WORD idxNext;        // Record of the next file in the directory
+static WORD idxBase;        // Record held in idxBuf[0]
+static BYTE idxLoaded;      // Records held in idxBuf
+static WAVINDEX idxBuf[idxWindow];
+
+static FRESULT nextWav(DIR* dir, FILINFO* fno);
+static FRESULT checkFmt(const WAVFMT* fmt, UINT len, WAVINDEX* rec);
+static FRESULT parseWav(FIL* fp, WAVINDEX* rec);
+static FRESULT startTrack(const WAVINDEX* rec);
+static void fwdPcm8(BYTE d);
+static void fwdPcm16(BYTE d);
+static void fwdPcm8Stereo(BYTE d);
+static void fwdPcm16Stereo(BYTE d);
+static void fwdAdpcm(BYTE d);
+static void mixPcm8(BYTE d);
+static void mixPcm16(BYTE d);
+#if hotClips
+static void hotPcm8(BYTE d);
+static void hotPcm16(BYTE d);
+#endif
+static void flashRead(const BYTE* p, UINT len);
 
 
 
@@ -51,97 +203,424 @@ void put_rc (FRESULT rc)
 	for (p = str, i = 0; i != rc && *p; i++) {
 		while(*p++) ;
 	}
-	printf("\trc=%i FR_%s\n\r", rc, p);
+	comPrintf("\trc=%i FR_%s\n\r", rc, p);
+        return;
+}
+
+/*-----------------------------------------------------------------------
+ * Take idxBuf to put the record of a track opened without the index
+ * together in (see openWav and wavFlashPlay), rather than have one more
+ * WAVINDEX on the stack.  The records it held are read again by the next
+ * idxFind that needs them.
+ *-----------------------------------------------------------------------*/
+static WAVINDEX* idxScratch(void)
+{
+    idxLoaded = 0;
+    return idxBuf;
+}
+
+/*-----------------------------------------------------------------------
+ * Open the playlist index in idxFil and read its header (see WAVINDEX).
+ * The file stays open for idxFind and buildIndex, so the directory is
+ * only searched for it once a pass.  idxState is left IDX_NONE if the
+ * card has no index, or IDX_STALE if it hasn't been built yet.
+ *-----------------------------------------------------------------------*/
+static void idxOpen(void)
+{
+    WAVINDEXHDR hdr;
+    UINT bReadCount;
+
+    idxState = IDX_NONE;
+    idxCount = idxNext = idxBase = 0;
+    idxLoaded = 0;
+    if (pf_fopen(&idxFil, idxFileName) != FR_OK) return;
+    if (pf_fread(&idxFil, &hdr, sizeof(hdr), &bReadCount) != FR_OK
+        || bReadCount != sizeof(hdr))       // Too small to ever hold an index
+    {
         return;
+    }
+    idxState = IDX_STALE;
+    if (hdr.magic != idxMagic || hdr.version != idxVersion) return;
+    idxCount = hdr.count;
+    idxFull = hdr.full;
+    idxState = IDX_OK;
+}
+
+/*-----------------------------------------------------------------------
+ * Find the index record of the next file in the directory (fno).  The
+ * index lists the files in directory order, so the records are read in
+ * step with pf_readdir, idxWindow at a time, and the file is only sought
+ * when they aren't read in order (see idxScratch).  Returns the record, in
+ * idxBuf until the next call, if it still matches the directory entry,
+ * or 0.  A record that doesn't, or a file the index doesn't reach, makes
+ * the index stale, and the rest of the files are opened by openWav.
+ *-----------------------------------------------------------------------*/
+static const WAVINDEX* idxFind(const FILINFO* fno)
+{
+    const WAVINDEX* rec;
+    UINT bReadCount;
+
+    if (idxState != IDX_OK) return 0;
+    if (idxNext >= idxCount) {
+        if (!idxFull) idxState = IDX_STALE;     // A file added since
+        return 0;
+    }
+    if ((WORD)(idxNext - idxBase) >= idxLoaded) {   // Read the next records
+        DWORD ofs = (DWORD)(idxNext + 1) * sizeof(WAVINDEX);
+
+        idxLoaded = 0;
+        if ((pf_ftell(&idxFil) != ofs && pf_flseek(&idxFil, ofs) != FR_OK)
+            || pf_fread(&idxFil, idxBuf, sizeof(idxBuf), &bReadCount) != FR_OK
+            || bReadCount < sizeof(WAVINDEX))
+        {
+            idxState = IDX_STALE;
+            return 0;
+        }
+        idxBase = idxNext;
+        idxLoaded = (BYTE)(bReadCount / sizeof(WAVINDEX));
+    }
+    rec = &idxBuf[idxNext++ - idxBase];
+    if (rec->fsize == fno->fsize && rec->fdate == fno->fdate
+        && rec->ftime == fno->ftime && rec->sclust == fno->fclust)
+    {
+        return rec;
+    }
+    idxState = IDX_STALE;                   // The file has changed
+    return 0;
+}
+
+/*-----------------------------------------------------------------------
+ * Write the 512 bytes at 'buf' over sector 'sectNo' of the playlist
+ * index.  pf_fwrite stops at the end of the file, so a last sector the
+ * file only partly covers is cut short.
+ *-----------------------------------------------------------------------*/
+static FRESULT idxWrite(WORD sectNo, const void* buf)
+{
+    FRESULT res;
+    UINT bw;
+
+    res = pf_flseek(&idxFil, (DWORD)sectNo * 512);
+    if (res == FR_OK) res = pf_fwrite(&idxFil, buf, 512, &bw);
+    if (res == FR_OK) res = pf_fwrite(&idxFil, 0, 0, &bw);  // Finalize a cut sector
+    return res;
+}
+
+/*-----------------------------------------------------------------------
+ * Rebuild the playlist index from the root directory (see WAVINDEX).
+ * Every file is opened and its headers read, and its record written to
+ * PLAYLIST.IDX.  The file keeps its size, so if there are more files
+ * than it has room for, the rest are left out and the header says so.
+ * The sectors are put together in the ring, which is free while nothing
+ * is playing.  The first one, holding the header, is written last, so an
+ * index left half built stays stale.  Returns FRESULT indicating success
+ * or (which) failure.
+ *-----------------------------------------------------------------------*/
+#define idxPerSect (512 / sizeof(WAVINDEX))
+
+#if ringBlocks * blockSamples * 2 < 1024
+#error The ring must hold two sectors for buildIndex
+#endif
+
+FRESULT buildIndex(void)
+{
+    WAVINDEX* const first = (WAVINDEX*)ring;        // Sector 0, the header first
+    WAVINDEX* const sect = first + idxPerSect;      // Sector being put together
+    WAVINDEXHDR* const hdr = (WAVINDEXHDR*)first;
+    WAVINDEX* rec;
+    DIR dir;
+    FILINFO fno;
+    FRESULT res;
+    DWORD room;                 // Records the file has room for
+    WORD sectNo = 0;            // Sector being put together
+    WORD count = 0;             // Records so far
+    BYTE n = 1;                 // Records in the sector
+    BYTE full = 0;
+
+    res = pf_fopen(&idxFil, idxFileName);
+    if (res != FR_OK) return res;
+    room = idxFil.fsize / sizeof(WAVINDEX);
+    if (room == 0) return FR_NO_FILE;       // No room for the header
+    room--;
+
+    memset(first, 0, 1024);
+    res = pf_opendir(&dir, "");
+    if (res != FR_OK) return res;
+    while (1) {
+        res = pf_readdir(&dir, &fno);
+        if (res != FR_OK) return res;
+        if (fno.fname[0] == 0) break;           // End of directory
+        if (fno.fattrib & AM_DIR) continue;     // Directories aren't listed
+        if (count == room) {
+            full = 1;
+            break;
+        }
+
+        rec = (sectNo ? sect : first) + n;
+        memset(rec, 0, sizeof(WAVINDEX));
+        if (pf_fopen_entry(&trackFil, &fno) != FR_OK || parseWav(&trackFil, rec) != FR_OK) {
+            rec->format = 0;                    // Not a file we can play
+        }
+        rec->fsize = fno.fsize;
+        rec->fdate = fno.fdate;
+        rec->ftime = fno.ftime;
+        rec->sclust = fno.fclust;
+        count++;
+
+        if (++n == idxPerSect) {                // Sector is complete
+            if (sectNo) {
+                res = idxWrite(sectNo, sect);
+                if (res != FR_OK) return res;
+            }
+            sectNo++;
+            n = 0;
+        }
+    }
+    if (sectNo && n) {                          // Last sector, part filled
+        memset(sect + n, 0, (idxPerSect - n) * sizeof(WAVINDEX));
+        res = idxWrite(sectNo, sect);
+        if (res != FR_OK) return res;
+    }
+
+    hdr->magic = idxMagic;
+    hdr->version = idxVersion;
+    hdr->count = count;
+    hdr->full = full;
+    return idxWrite(0, first);
 }
 
 /*-----------------------------------------------------------------------
  * Attempts to play all files located in the root directory of passed file
  * system.  Will continue playing root directory in a loop. Returns FRESULT
- * indicating success or (which) failure.
+ * indicating success or (which) failure.  The playlist index is used to
+ * start the tracks if there is one, and is rebuilt after the pass if it
+ * turned out to be out of date.
  *-----------------------------------------------------------------------*/
 FRESULT rootPlay(void)
 {
     BYTE res;
     DIR dir = {0};		/* Directory object */
     FILINFO fno = {0};		/* File information */
-    char path[128] = {NULL};    /* Set path to root directory */
     
+    trackMap[0] = sizeof(trackMap) / sizeof(trackMap[0]);
+    trackFil.cltbl = trackMap;
+    idxOpen();
     /* Open root directory, if error opening, print and break. */
-    res = pf_opendir(&dir, path);
+    res = pf_opendir(&dir, "");     /* The root directory */
     if (res) {
-        printf("opendir error; ");
+        comPrintf("opendir error; ");
         return res;
     }
-    /* This WHILE loop attempts to read all the files in the root directory.
-     * If the file opens succesfully, it prints the name to console,
-     * and sends the file to openWav. */
+    /* This WHILE loop finds the first wav file in the root directory and
+     * has playWav play it.  playWav carries on with the files after it
+     * without a gap, so this only loops again if playing stopped on an
+     * error. */
     while(1) {
-        res = pf_readdir(&dir, &fno);
-        if (res != FR_OK) { put_rc(res); break; }   // break because opening directory failed
+        res = nextWav(&dir, &fno);
+        if (res != FR_OK) { put_rc(res); break; }   // break because reading directory failed
         if (fno.fname[0] == 0) {
-            printf("End of directory\n\n\r");
+            comPrintf("End of directory\n\n\r");
             break;               // break because all entries read
         }
 
-        if (fno.fattrib & AM_DIR) { // A DIRECTORY was read
-            printf("   <DIR>   %s\n\r", fno.fname);   // print directory name
-        } else {                    // A FILE was read
-            /* Attempt to open the file and if it is the correct format, play it. */
-            res = openWav(fno.fname);
-            if (res == 0) {
-                BYTE playRes;
-                printf("Playing %s\n\r", fno.fname);
-                playRes = playWav();    // Note, playWay is only called if openWav returned successfully
-                if (playRes != FR_WAV_END) put_rc(playRes);
+        BYTE playRes;
+        comPrintf("Playing %s%s\n\r", fno.fname, pf_fcontig(&trackFil) ? "" : " (fragmented)");
+        playRes = playWav(&dir);    // Note, playWav is only called if openWav returned successfully
+        if (playRes != FR_WAV_END) put_rc(playRes);
+    }
+
+    // Files removed since the index was built leave records unused
+    if (idxState == IDX_OK && idxNext < idxCount) idxState = IDX_STALE;
+    if (res == FR_OK && idxState == IDX_STALE) {
+        comPrintf("Rebuilding %s\n\r", idxFileName);
+        BYTE idxRes = buildIndex();
+        if (idxRes != FR_OK) put_rc(idxRes);    // Not fatal, the files still play
+    }
+    return res;
+}
+
+/*-----------------------------------------------------------------------
+ * Read on through directory 'dir' to the next file that opens as a wav
+ * file (see openWav), printing the entries skipped.  A file the playlist
+ * index knows is started from its record instead, and skipped without
+ * being opened if it isn't playable.  fno->fname[0] is 0 at the end of
+ * the directory.
+ *-----------------------------------------------------------------------*/
+static FRESULT nextWav(DIR* dir, FILINFO* fno)
+{
+    FRESULT res;
+
+    while (1) {
+        res = pf_readdir(dir, fno);
+        if (res != FR_OK || fno->fname[0] == 0) return res;
+
+        if (fno->fattrib & AM_DIR) {    // A DIRECTORY was read
+            comPrintf("   <DIR>   %s\n\r", fno->fname);   // print directory name
+        } else {                        // A FILE was read
+            const WAVINDEX* rec = idxFind(fno);
+
+            if (rec) {
+                if (!rec->format) continue;         // Indexed as not playable
+                wavFormatGood = 0;
+                res = pf_fopen_entry(&trackFil, fno);
+                if (res == FR_OK) res = pf_flseek(&trackFil, rec->dataOfs);    // Straight to the samples
+                if (res == FR_OK) res = startTrack(rec);
             } else {
-                printf("Failed opening %s as a wav file\n\r", fno.fname);
-                put_rc(res);
+                res = openWav(fno);
             }
+            if (res == FR_OK) return res;
+            comPrintf("Failed opening %s as a wav file\n\r", fno->fname);
+            put_rc(res);
         }
     }
-    return res;
 }
 
 /*-----------------------------------------------------------------------
- * openWav attempts to open the file passed to it (fname).  openWav looks
- * for a wav file format and checks that the format meets limits imposed by
- * hardware.  Returns FRESULT indicating success or (which) failure.
+ * Work out the Timer2 setup that ticks 'rate' times per second.  The
+ * timer is given the smallest prescaler/postscaler division that fits a
+ * sample period in PR2.  The period is rarely a whole number of timer
+ * counts, so it is split into a whole part (tickPR2 + 1 counts) and a
+ * fraction tickFrac/rate.  The ISR adds the fraction up every tick and
+ * makes the next period one count longer each time it passes a whole
+ * count, so any 'rate' ticks take exactly one second.  The setup is left
+ * in next*, for the ISR to switch to at the start of the track.  Returns
+ * 0 if the rate can't be generated.
+ *-----------------------------------------------------------------------*/
+static BYTE setSampleRate(DWORD rate)
+{
+    static const BYTE t2Div[] = {1, 2, 4, 8, 16};
+    static const BYTE t2Con[] = {   // TMR2ON, postscaler and prescaler
+        0x04,       // 1:1, 1:1
+        0x0C,       // 1:2, 1:1
+        0x05,       // 1:1, 1:4
+        0x0D,       // 1:2, 1:4
+        0x06        // 1:1, 1:16
+    };
+    DWORD counts;               // Timer counts per second
+    BYTE i;
+
+    if (rate == 0 || rate > maxSampleRate) return 0;
+    for (i = 0; i < sizeof(t2Div); i++) {
+        counts = instrFreq / t2Div[i];
+        if (counts / rate < 256) break;     // Period fits PR2 with a count to spare
+    }
+    if (i == sizeof(t2Div)) return 0;       // Too slow
+
+    nextT2CON = t2Con[i];
+    nextPR2 = (BYTE)(counts / rate - 1);
+    nextFrac = (WORD)(counts % rate);
+    nextRem = (WORD)rate - nextFrac;
+    return 1;
+}
+
+/*-----------------------------------------------------------------------
+ * Check the fmt chunk 'fmt' ('len' bytes of it read) describes a format
+ * the hardware can play, and note the format in 'rec'.  A
+ * WAVE_FORMAT_EXTENSIBLE chunk is taken as the format of its sub format
+ * tag.  Returns FRESULT indicating success or (which) failure.
  *-----------------------------------------------------------------------*/
-FRESULT openWav(const char* fname)
+static FRESULT checkFmt(const WAVFMT* fmt, UINT len, WAVINDEX* rec)
+{
+    WORD compress = fmt->compress;
+
+    if (compress == WAVE_FORMAT_EXTENSIBLE) {
+        if (len < sizeof(WAVFMT) || fmt->extraBytes < 22
+            || memcmp(fmt->guid, fmtGuid, sizeof(fmtGuid)))
+        {
+            comPrintf("Bad extensible format\n\r");
+            return FR_WAV_TYPE_UNSUPPORTED;
+        }
+        compress = fmt->subFormat;
+    }
+
+    /* Check format chunk to make sure file is supported by this program and wavsheild. */
+    /* The print messages explain the conditions being tested for. */
+    // The sample count and refill sizes are divided by these
+    if (fmt->channels == 0 || fmt->blockAlign == 0) {
+        comPrintf("No channels or empty blocks\n\r");
+        return FR_WAV_TYPE_UNSUPPORTED;
+    }
+    if (compress == WAVE_FORMAT_IMA_ADPCM) {
+        // Blocks of a 4 byte header, holding the first sample, and then
+        // two 4-bit samples to a byte.
+        if (len < 20 || fmt->extraBytes < 2 || fmt->bitsPerSample != 4
+            || fmt->blockAlign < 5
+            || fmt->samplesPerBlock != (fmt->blockAlign - 4) * 2 + 1)
+        {
+            comPrintf("Bad IMA ADPCM format\n\r");
+            return FR_WAV_TYPE_UNSUPPORTED;
+        }
+    } else if (compress != WAVE_FORMAT_PCM) {
+        comPrintf("Compression not supported\n\r");
+        return FR_WAV_TYPE_UNSUPPORTED;
+    }
+    rec->format = (BYTE)compress;
+    rec->blockAlign = fmt->blockAlign;
+    if (fmt->channels > (rec->format == WAVE_FORMAT_PCM ? 2 : 1)) {
+        comPrintf("Not mono or stereo PCM\n\r");
+        return FR_WAV_TYPE_UNSUPPORTED;
+    }
+    rec->bits = (BYTE)fmt->bitsPerSample;
+    if (fmt->bitsPerSample > 16) {
+        comPrintf("More than 16 bits per sample!\n\r");
+        return FR_WAV_TYPE_UNSUPPORTED;
+    }
+    // PCM blocks are one sample of each channel, startTrack tells stereo
+    // from mono by their size.
+    if (rec->format == WAVE_FORMAT_PCM
+        && rec->blockAlign != fmt->channels * (rec->bits == 16 ? 2 : 1))
+    {
+        comPrintf("Only 8 and 16 bit PCM supported\n\r");
+        return FR_WAV_TYPE_UNSUPPORTED;
+    }
+    // No limit on bytesPerSecond: the sample clock is bounded below, and
+    // a file the card can't keep up with shows up in wavStats.underruns.
+    rec->rate = fmt->sampleRate;
+    if (rec->rate < minSampleRate || rec->rate > maxSampleRate) {
+        comPrintf("Sample rate %lu not supported\n\r", rec->rate);
+        return FR_WAV_TYPE_UNSUPPORTED;
+    }
+
+// <editor-fold defaultstate="collapsed" desc="Change sample rate">
+//    OpenADC(ADC_FOSC_4 & ADC_LEFT_JUST & ADC_4_TAD, ADC_CH0 & ADC_INT_OFF, ADC_REF_VDD_VSS);
+// </editor-fold>
+    return FR_OK;
+}
+
+/*-----------------------------------------------------------------------
+ * parseWav reads the headers of the file just opened in 'fp'.  It walks
+ * the RIFF chunks once, in whatever order they come, jumping over the
+ * ones it doesn't need (LIST, bext, ...) and the pad byte after a chunk
+ * of odd length.  It checks that the fmt chunk describes a format the
+ * hardware can play, WAVE_FORMAT_EXTENSIBLE included, and notes where
+ * the data, smpl and cue chunks are.  The samples are described in 'rec'
+ * (all but the directory entry fields) and the file is left at the first
+ * one.  Nothing is set up to play, see startTrack.  Returns FRESULT
+ * indicating success or (which) failure.
+ *-----------------------------------------------------------------------*/
+static FRESULT parseWav(FIL* fp, WAVINDEX* rec)
 {
     BYTE res;
     const UINT wavHeaderLen = 12;
-    const UINT fmtHeaderLen = 8;
-    UINT bReadCount;            /* Number of bytes read by pf_read() */
+    const UINT chunkHeaderLen = 8;
+    UINT bReadCount;            /* Number of bytes read by pf_fread() */
+    DWORD factLen = 0;          /* Sample count from the fact chunk, if there is one */
+    DWORD pos;                  /* File offset of the chunk header to read next */
+    DWORD end;                  /* End of the RIFF chunk */
+    DWORD body;                 /* File offset of the chunk's contents */
+    DWORD size;                 /* Length of the chunk's contents */
+    UINT fmtLen = 0;            /* Bytes of the fmt chunk read, 0 until it is found */
 
     union {
         struct {
             BYTE id[4];
             DWORD size;
             BYTE data[4];
-        } riff;  // Wave Header
-        struct {
-            UINT compress;
-            UINT channels;
-            DWORD sampleRate;
-            DWORD bytesPerSecond;
-            UINT blockAlign;
-            UINT bitsPerSample;
-            UINT extraBytes;
-        } fmt; // fmt chunk
+        } riff;  // Wave Header, the first 8 bytes are also the chunk headers
+        WAVFMT fmt;     // fmt chunk
     } buf;
 
-    // This file must be verified before we set wavFormatGood to True
-    wavFormatGood = 0;
-
-    res = pf_open(fname);        // attempt to open file
-    if (res != 0) {              // Error opening file
-        printf("%s failed to open\n\n\r", fname);
-        return res;
-    }
     /* Read the WAVE file header and check for correctness. */
-    res = pf_read(&buf, wavHeaderLen, &bReadCount);
+    res = pf_fread(fp, &buf, wavHeaderLen, &bReadCount);
     if (res != 0) return res;                  // File read error 
     if (bReadCount != wavHeaderLen             // Unexpected number of bytes read
         || strncmp(buf.riff.id, "RIFF", 4)     // Incorrect header
@@ -149,50 +628,140 @@ FRESULT openWav(const char* fname)
     {
         return FR_NOT_WAV_FILE;
     }
-    
-    /* Read the FORMAT chunk header and check for correctness. */
-    res = pf_read(&buf, fmtHeaderLen, &bReadCount);
-    if (res != 0) return res;                   // File read error 
-    if (bReadCount != fmtHeaderLen              // Unexpected number of bytes read
-        || strncmp(buf.riff.id, "fmt ", 4))     // Incorrect header (note ending space)
-    {
-        return FR_NOT_WAV_FILE;
-    }
-    /* Read FORMAT chunk (if it's 16 or 18 bytes long) and check for wave format compatibility. */
-    UINT size = buf.riff.size;
-    if (size == 16 || size == 18) {
-        res = pf_read(&buf, size, &bReadCount);
-        if (res != 0) return res;               // File read error 
-        if (bReadCount != size) {               // Unexpected number of bytes read
-            return FR_NOT_WAV_FILE;
+    end = buf.riff.size + 8;
+    if (end > fp->fsize || end < 8) end = fp->fsize;    // Cut short, or a wrong size
+
+    /* Walk the chunks.  The file is only sought when the last chunk
+     * wasn't read to its end, and for a mapped or contiguous file the
+     * seek is worked out without reading the card. */
+    rec->dataOfs = rec->dataLen = 0;
+    rec->smplOfs = rec->smplLen = 0;
+    rec->cueOfs = rec->cueLen = 0;
+    for (pos = wavHeaderLen; pos + chunkHeaderLen <= end; pos = body + size + (size & 1)) {
+        if (pf_ftell(fp) != pos) {
+            res = pf_flseek(fp, pos);
+            if (res != 0) return res;
         }
-    } else {
-        printf("FORMAT chunk not 16 or 18 bytes long.\n\r");
-        return FR_WAV_TYPE_UNSUPPORTED;
-    }
+        res = pf_fread(fp, &buf, chunkHeaderLen, &bReadCount);
+        if (res != 0) return res;               // File read error
+        if (bReadCount != chunkHeaderLen) break;
+        body = pos + chunkHeaderLen;
+        size = buf.riff.size;
+        if (size > end - body) size = end - body;   // Cut short
 
-    /* Check format chunk to make sure file is supported by this program and wavsheild. */
-    /* The print messages explain the conditions being tested for. */
-    if (buf.fmt.compress != 1 || (size == 18 && buf.fmt.extraBytes != 0)) {
-        printf("Compression not supported\n\r");
-        return FR_WAV_TYPE_UNSUPPORTED;
+        if (!strncmp(buf.riff.id, "fmt ", 4)) {     // Note ending space
+            fmtLen = size < sizeof(buf.fmt) ? (UINT)size : sizeof(buf.fmt);
+            if (fmtLen < 16) {
+                comPrintf("FORMAT chunk too short.\n\r");
+                return FR_WAV_TYPE_UNSUPPORTED;
+            }
+            memset(&buf, 0, sizeof(buf));
+            res = pf_fread(fp, &buf, fmtLen, &bReadCount);
+            if (res != 0) return res;           // File read error
+            if (bReadCount != fmtLen) return FR_NOT_WAV_FILE;
+            res = checkFmt(&buf.fmt, fmtLen, rec);
+            if (res != FR_OK) return res;
+        } else if (!strncmp(buf.riff.id, "data", 4)) {
+            rec->dataOfs = body;
+            rec->dataLen = size;
+        } else if (!strncmp(buf.riff.id, "fact", 4) && size >= 4) {
+            // Compressed files say how many samples they really hold
+            res = pf_fread(fp, &factLen, 4, &bReadCount);
+            if (res != 0) return res;
+        } else if (!strncmp(buf.riff.id, "smpl", 4)) {
+            rec->smplOfs = body;
+            rec->smplLen = size;
+        } else if (!strncmp(buf.riff.id, "cue ", 4)) {
+            rec->cueOfs = body;
+            rec->cueLen = size;
+        }
     }
-    if (buf.fmt.channels > 1) {
-        printf("Not mono\n\r");
-        return FR_WAV_TYPE_UNSUPPORTED;
+    if (!fmtLen || !rec->dataOfs) return FR_NOT_WAV_FILE;
+    comPrintf("Data chunk size: %lu\n\r", rec->dataLen);
+
+    // Work out the number of samples to play.  A short last ADPCM block
+    // still holds its header sample and two samples to each further byte.
+    if (rec->format == WAVE_FORMAT_IMA_ADPCM) {
+        UINT rest = (UINT)(rec->dataLen % rec->blockAlign);
+        rec->samples = rec->dataLen / rec->blockAlign * ((rec->blockAlign - 4) * 2 + 1);
+        if (rest >= 4) rec->samples += (rest - 4) * 2 + 1;
+        if (factLen && factLen < rec->samples) rec->samples = factLen;    // Drop the padding
+    } else {
+        rec->samples = rec->dataLen / rec->blockAlign;
     }
-    bitsPerSample = buf.fmt.bitsPerSample;
-    if (bitsPerSample > 16) {
-        printf("More than 16 bits per sample!\n\r");
+    return pf_flseek(fp, rec->dataOfs);     // Off to the first sample
+}
+
+/*-----------------------------------------------------------------------
+ * Make the open file, which is at its first sample, the track read into
+ * the ring from now on.  'rec' describes its samples, see parseWav.  A
+ * clip in program flash is made the track by setting trackFlash after.
+ * The track's sample clock waits in next* for the ISR, see
+ * setSampleRate, and trackForward is the sink for its format.
+ * Returns FRESULT indicating success or (which) failure.
+ *-----------------------------------------------------------------------*/
+static FRESULT startTrack(const WAVINDEX* rec)
+{
+    if (!setSampleRate(rec->rate)) {
+        comPrintf("Sample rate %lu not supported\n\r", rec->rate);
         return FR_WAV_TYPE_UNSUPPORTED;
     }
-    if (buf.fmt.bytesPerSecond > 44100){
-        printf("Sample rate too fast.\n\r");
-        return FR_WAV_TYPE_UNSUPPORTED;
+    wavFormat = rec->format;
+    trackFlash = 0;
+    if (wavFormat == WAVE_FORMAT_IMA_ADPCM) {
+        bytesPerFrame = 1;
+        trackForward = fwdAdpcm;
+    } else {
+        bytesPerFrame = (BYTE)rec->blockAlign;
+        switch (bytesPerFrame) {
+        case 1: trackForward = fwdPcm8; break;
+        case 2: trackForward = rec->bits == 16 ? fwdPcm16 : fwdPcm8Stereo; break;
+        default: trackForward = fwdPcm16Stereo;
+        }
     }
+    adpcmBlockAlign = rec->blockAlign;
+    adpcmPos = 0;
+    trackBytes = rec->dataLen;
+    trackSamples = rec->samples;
+
+    // The sample data usually starts at byte 44, so full size refills would
+    // each straddle two sectors.  Make the first fill a short one that ends
+    // on a boundary, so every following refill reads whole sectors (or
+    // parts of one).  The ISR just plays a short first block.
+    fillLen = blockSamples * bytesPerFrame;
+    if (wavFormat == WAVE_FORMAT_IMA_ADPCM) fillLen /= 2;   // Up to two samples a byte
+    nextLen = (fillLen - (UINT)(rec->dataOfs % fillLen)) & ~(UINT)(bytesPerFrame - 1);
+    if (nextLen == 0) nextLen = fillLen;    // Odd offset, can't align whole samples
+    trackStart = 1;
 
     // We made, it's a wav file with appropriate formating
     wavFormatGood = 1;      // wavFormatGood is true
+    return FR_OK;
+}
+
+/*-----------------------------------------------------------------------
+ * openWav attempts to open the file passed to it (fno, as returned by
+ * pf_readdir).  The file is opened straight from its directory entry, so
+ * the directory isn't searched again.  Its headers are checked (see
+ * parseWav) and it is left at the first sample, ready to be read into
+ * the ring.  Returns FRESULT indicating success or (which) failure.
+ *-----------------------------------------------------------------------*/
+FRESULT openWav(const FILINFO* fno)
+{
+    FRESULT res;
+    WAVINDEX* rec;
+
+    // This file must be verified before we set wavFormatGood to True
+    wavFormatGood = 0;
+
+    res = pf_fopen_entry(&trackFil, fno);   // attempt to open file
+    if (res != 0) {              // Error opening file
+        comPrintf("%s failed to open\n\n\r", fno->fname);
+        return res;
+    }
+    rec = idxScratch();
+    res = parseWav(&trackFil, rec);
+    if (res == FR_OK) res = startTrack(rec);
     return res;
 }
 
@@ -202,16 +771,580 @@ FRESULT openWav(const char* fname)
 //BYTE update = 0;
 // </editor-fold>
 
+/*-----------------------------------------------------------------------
+ * Decode a 4-bit IMA ADPCM sample and store it as a DAC word at fillPos.
+ * The predictor is kept in offset binary so that it can be clamped with
+ * 16-bit unsigned compares, and its top 12 bits are the DAC value.
+ *-----------------------------------------------------------------------*/
+static void adpcmNibble(BYTE n)
+{
+    WORD step = adpcmStep[adpcmIndex];
+    WORD diff = step >> 3;
+
+    if (n & 4) diff += step;
+    if (n & 2) diff += step >> 1;
+    if (n & 1) diff += step >> 2;
+    if (n & 8) {
+        adpcmPred = diff > adpcmPred ? 0 : adpcmPred - diff;
+    } else {
+        adpcmPred = diff > 0xFFFF - adpcmPred ? 0xFFFF : adpcmPred + diff;
+    }
+
+    n = adpcmIndex + adpcmIndexAdj[n & 7];
+    adpcmIndex = n > 88 ? (n & 0x80 ? 0 : 88) : n;
+
+    *fillPos++ = dacConfig | (adpcmPred >> 4);
+}
+
+/*-----------------------------------------------------------------------
+ * Data forwarding sinks of pf_read (see FORWARD() in pffconf.h), one for
+ * each kind of sample data.  startTrack picks the track's one and
+ * fillBlock points pf_forward at it, so the SPI receive loop only does
+ * the work its format needs.
+ * Each is called with every byte of the sample data, converts every
+ * complete sample into the 16-bit command word the DAC expects and
+ * stores it at fillPos, so the data is never held in its file format and
+ * the ISR only ever sees DAC words.  Stereo is mixed down to mono by
+ * averaging the channels.
+ *-----------------------------------------------------------------------*/
+static void fwdPcm8(BYTE d)         // 8-bit samples are unsigned
+{
+    *fillPos++ = dac8Bit[d];
+}
+
+static void fwdPcm16(BYTE d)        // 16-bit samples are signed, low byte first
+{
+    if (!fillPhase) {
+        fillLow = d;
+        fillPhase = 1;
+        return;
+    }
+    fillPhase = 0;
+    *fillPos++ = dacConfig | ((WORD)(d ^ 0x80) << 4) | (fillLow >> 4);
+}
+
+static void fwdPcm8Stereo(BYTE d)   // Left, then right
+{
+    if (!fillPhase) {
+        fillLow = d;
+        fillPhase = 1;
+        return;
+    }
+    fillPhase = 0;
+    *fillPos++ = dac8Bit[(BYTE)(((WORD)fillLow + d) >> 1)];
+}
+
+static void fwdPcm16Stereo(BYTE d)  // Left, then right, each low byte first
+{
+    switch (fillPhase++) {
+    case 0:
+    case 2:
+        fillLow = d;
+        return;
+    case 1:                         // Halve in offset binary, so the sum can't overflow
+        fillMix = ((WORD)(d ^ 0x80) << 8 | fillLow) >> 1;
+        return;
+    }
+    fillPhase = 0;
+    fillMix += ((WORD)(d ^ 0x80) << 8 | fillLow) >> 1;
+    *fillPos++ = dacConfig | (fillMix >> 4);
+}
+
+static void fwdAdpcm(BYTE d)        // IMA ADPCM is decoded here too
+{
+    switch (adpcmPos++) {
+    case 0:                         // Block header: first sample, low byte
+        adpcmPred = d;
+        break;
+    case 1:                         // High byte, signed
+        adpcmPred |= (WORD)(d ^ 0x80) << 8;
+        break;
+    case 2:                         // Step index
+        adpcmIndex = d > 88 ? 88 : d;
+        break;
+    case 3:                         // Reserved, the header sample is played now
+        *fillPos++ = dacConfig | (adpcmPred >> 4);
+        break;
+    default:                        // Two samples, low nibble first
+        adpcmNibble(d & 0x0F);
+        adpcmNibble(d >> 4);
+    }
+    if (adpcmPos == adpcmBlockAlign) adpcmPos = 0;
+}
+
+/*-----------------------------------------------------------------------
+ * Sinks that mix a sound effect voice into DAC words already in a block
+ * (see mixBlock).  Each sample is taken to a signed 12-bit value, scaled
+ * by mixGain (mixUnity is 1) and added to the word at fillPos, clipped to
+ * the DAC's range.
+ * mixScale works out v * mixGain >> 7 from the two bytes of v, so it
+ * takes two 8x8 multiplies, which the PIC18 does in hardware (mullw),
+ * instead of a 32-bit library multiply.  The top byte of a 12-bit 'v' is
+ * -8 to 7, so neither product overflows, and the result is exact.
+ *-----------------------------------------------------------------------*/
+static SHORT mixScale(SHORT v)
+{
+    return (SHORT)((signed char)(v >> 8) * mixGain) * 2
+        + (SHORT)(((WORD)(BYTE)v * mixGain) >> 7);
+}
+
+static void mixSample(SHORT v)
+{
+    SHORT m = (SHORT)(*fillPos & 0x0FFF) + mixScale(v);
+
+    if (m < 0) m = 0;
+    else if (m > 0x0FFF) m = 0x0FFF;
+    *fillPos++ = dacConfig | m;
+}
+
+static void mixPcm8(BYTE d)         // 8-bit samples are unsigned
+{
+    mixSample(((SHORT)d - 128) << 4);
+}
+
+static void mixPcm16(BYTE d)        // 16-bit samples are signed, low byte first
+{
+    if (!fillPhase) {
+        fillLow = d;
+        fillPhase = 1;
+        return;
+    }
+    fillPhase = 0;
+    mixSample((SHORT)((WORD)d << 8 | fillLow) >> 4);
+}
+
+#if hotClips
+/*-----------------------------------------------------------------------
+ * Sinks that store the first samples of a hot clip in RAM, see
+ * wavHotLoad.  Each is stored as mixSample would add it, scaled by
+ * mixGain, and rounded to the 8 bits kept, so the ISR only has to add it
+ * and clip the sum.
+ *-----------------------------------------------------------------------*/
+static void hotStore(SHORT s)
+{
+    s = (s + 8) >> 4;
+    if (s < -128) s = -128;
+    else if (s > 127) s = 127;
+    *hotFill++ = (signed char)s;
+}
+
+static void hotPcm8(BYTE d)         // 8-bit samples are unsigned
+{
+    hotStore(mixScale(((SHORT)d - 128) << 4));
+}
+
+static void hotPcm16(BYTE d)        // 16-bit samples are signed, low byte first
+{
+    if (!fillPhase) {
+        fillLow = d;
+        fillPhase = 1;
+        return;
+    }
+    fillPhase = 0;
+    hotStore(mixScale((SHORT)((WORD)d << 8 | fillLow) >> 4));
+}
+#endif
+
+/*-----------------------------------------------------------------------
+ * Forward 'len' bytes of a clip in program flash, from 'p' on, to
+ * the forwarding sink, as pf_fread does with the bytes it reads.
+ *-----------------------------------------------------------------------*/
+static void flashRead(const BYTE* p, UINT len)
+{
+    while (len--) FORWARD(*p++);
+}
+
+/*-----------------------------------------------------------------------
+ * Mix voice 'v' into ring block v->blk and move it on to the next block.
+ * The clip's samples from v->pos on are forwarded by pf_fread from the
+ * voice's own file object straight to its mixing sink, apart from the
+ * first v->skip, which the ISR plays from RAM.  The file is only sought
+ * when it isn't already at the first one, and for a contiguous clip the
+ * seek is worked out without reading the card.  A clip in program flash
+ * is forwarded by flashRead instead.  A block the ISR has already taken
+ * is passed over and counted in wavStats.
+ * A block waiting for the ISR (see wavHotPlay and playWav) is taken back
+ * from it while it is mixed, by pulling ringHead back to it, so the ISR
+ * never reads a word half written.  Should the ISR get to it before the
+ * mix is done, it holds the last sample until ringHead is put back, and
+ * counts an underrun, as when a refill is late.
+ *-----------------------------------------------------------------------*/
+static FRESULT mixVoice(WAVVOICE* v)
+{
+    BYTE i = v->blk & ringMask;
+    WORD n = ringLen[i];
+    BYTE bps = v->bits / 8;             // Bytes per sample
+    DWORD first = v->pos < v->skip ? v->skip : v->pos;
+    DWORD end = v->pos + n;
+    DWORD ofs;
+    FRESULT res = FR_OK;
+    UINT bReadCount;
+    BYTE head = ringHead;
+    BYTE ie = PIE1bits.TMR2IE;
+    BYTE late;
+
+    if (end > v->samples) end = v->samples;
+    if (first < end) {
+        PIE1bits.TMR2IE = 0;
+        late = (BYTE)(v->blk - ringTail) > ringMask;
+        if (!late) ringHead = v->blk;       // Hold the ISR off this block
+        PIE1bits.TMR2IE = ie;
+        if (late) {
+            wavStats.mixLate++;             // Too late, the ISR has it
+        } else {
+            ofs = v->dataOfs + first * bps;
+            if (!v->flash && pf_ftell(&v->fil) != ofs) res = pf_flseek(&v->fil, ofs);
+            if (res == FR_OK) {
+                fillPos = ring[i] + (WORD)(first - v->pos);
+                fillPhase = 0;
+                mixGain = v->gain;
+                pf_forward(bps == 2 ? mixPcm16 : mixPcm8);
+                if (v->flash) {
+                    flashRead(v->flash + ofs, (UINT)(end - first) * bps);
+                } else {
+                    res = pf_fread(&v->fil, 0, (UINT)(end - first) * bps, &bReadCount);
+                }
+            }
+            ringHead = head;                // Give the blocks back
+            if (res != FR_OK) return res;   // File read error
+        }
+    }
+    v->pos += n;
+    v->blk++;
+    if (v->pos >= v->samples) v->on = 0;    // Clip is over
+    return FR_OK;
+}
+
+/*-----------------------------------------------------------------------
+ * Mix the voices that are playing into every ring block up to (but not
+ * including) block 'upto', see mixVoice.  The loop in playWav calls it
+ * for the blocks already waiting, so a voice started between refills is
+ * caught up straight away, and fillBlock for the block it fills.
+ *-----------------------------------------------------------------------*/
+static FRESULT mixQueued(BYTE upto)
+{
+    WAVVOICE* v;
+    FRESULT res;
+
+    for (v = voices; v < voices + mixVoices; v++) {
+        while (v->on && v->blk != upto) {
+            res = mixVoice(v);
+            if (res != FR_OK) return res;
+        }
+    }
+    return FR_OK;
+}
+
+/*-----------------------------------------------------------------------
+ * Load the mono 8 or 16-bit PCM file 'path' as the clip of voice 'v'.
+ * Its headers are read (see parseWav) and it is kept open in the voice's
+ * file object, ready for wavVoicePlay.  Any clip the voice had is
+ * stopped.  Returns FRESULT indicating success or (which) failure.
+ *-----------------------------------------------------------------------*/
+FRESULT wavVoiceLoad(BYTE v, const char* path)
+{
+    WAVVOICE* vp = &voices[v];
+    WAVINDEX rec;
+    FRESULT res;
+
+    wavVoiceStop(v);
+    vp->bits = 0;
+    vp->flash = 0;
+    vp->gain = mixUnity;
+#if hotClips
+    if (v < hotClips) hotCount[v] = 0;
+#endif
+    vp->map[0] = voiceMapLen;
+    vp->fil.cltbl = vp->map;
+    res = pf_fopen(&vp->fil, path);
+    if (res == FR_OK) res = parseWav(&vp->fil, &rec);
+    if (res != FR_OK) return res;
+    if (rec.format != WAVE_FORMAT_PCM || rec.blockAlign != (rec.bits == 16 ? 2 : 1)) {
+        comPrintf("Voice needs mono PCM\n\r");
+        return FR_WAV_TYPE_UNSUPPORTED;
+    }
+    vp->bits = rec.bits == 16 ? 16 : 8;
+    vp->dataOfs = rec.dataOfs;
+    vp->samples = rec.samples;
+    return FR_OK;
+}
+
+/*-----------------------------------------------------------------------
+ * Load 'path' as the clip of voice 'v' (see wavVoiceLoad) and keep its
+ * first hotLen samples in RAM for wavHotPlay, scaled to level 'gain'
+ * (see mixUnity), which wavHotPlay plays the whole clip at.  Only voices
+ * below hotClips have room for them; the others are loaded as plain
+ * voices, which wavHotPlay starts from the card at 'gain'.  Meant for
+ * startup, as it reads the directory and headers, and multiplies out
+ * every sample held.  The voice's file object is left just past the
+ * samples held, which is where the card takes over after the first
+ * wavHotPlay.  Returns FRESULT indicating success or (which) failure.
+ *-----------------------------------------------------------------------*/
+FRESULT wavHotLoad(BYTE v, const char* path, BYTE gain)
+{
+    WAVVOICE* vp = &voices[v];
+    FRESULT res;
+#if hotClips
+    UINT len, bReadCount;
+#endif
+
+    res = wavVoiceLoad(v, path);
+    if (res != FR_OK) return res;
+    vp->gain = gain;
+#if hotClips
+    if (v >= hotClips) return FR_OK;        // No room, it plays from the card
+
+    len = vp->samples < hotLen ? (UINT)vp->samples : hotLen;
+    hotFill = hotBuf[v];
+    fillPhase = 0;
+    mixGain = gain;
+    pf_forward(vp->bits == 16 ? hotPcm16 : hotPcm8);
+    res = pf_fread(&vp->fil, 0, len * (vp->bits / 8), &bReadCount);
+    if (res != FR_OK) return res;           // File read error
+    hotCount[v] = (WORD)(hotFill - hotBuf[v]);
+    hotGain[v] = gain;
+#endif
+    return FR_OK;
+}
+
+/*-----------------------------------------------------------------------
+ * Make clip 'clip' of program flash (see flashClips.h) the clip of voice
+ * 'v', in place of a file.  It is mixed in without reading the card, so
+ * it works before pf_mount too, and plays at the track's sample rate
+ * like any voice.  Any clip the voice had is stopped.  Returns FRESULT
+ * indicating success or (which) failure.
+ *-----------------------------------------------------------------------*/
+FRESULT wavFlashVoice(BYTE v, BYTE clip)
+{
+    WAVVOICE* vp = &voices[v];
+
+    wavVoiceStop(v);
+    vp->bits = 0;
+#if hotClips
+    if (v < hotClips) hotCount[v] = 0;
+#endif
+    if (clip >= clipCount) return FR_NO_FILE;
+    vp->flash = wavClips[clip].data;
+    vp->dataOfs = 0;
+    vp->samples = wavClips[clip].samples;
+    vp->bits = wavClips[clip].bits;
+    return FR_OK;
+}
+
+/*-----------------------------------------------------------------------
+ * Play the clip of voice 'v' from the start at level 'gain' (see
+ * mixUnity), over whatever it was playing.  It is mixed in from the next
+ * ring block filled.  Nothing happens if the voice has no clip loaded.
+ *-----------------------------------------------------------------------*/
+void wavVoicePlay(BYTE v, BYTE gain)
+{
+    WAVVOICE* vp = &voices[v];
+
+    if (!vp->bits) return;
+    vp->gain = gain;
+    vp->pos = 0;
+    vp->skip = 0;
+    vp->blk = ringHead;
+    vp->on = 1;
+}
+
+/*-----------------------------------------------------------------------
+ * Play the clip of voice 'v' from the start at the level it was loaded
+ * at, with its first samples mixed in by the ISR from RAM from the start
+ * of the next block it takes (see wavHotLoad), over any attack it was
+ * playing.  The rest is mixed from the card into the blocks waiting
+ * after that one, the next time round the loop in playWav, which has a
+ * block's time to do it.  A voice without samples in RAM, or any voice
+ * when hotClips is 0, is started by wavVoicePlay instead, at the level
+ * it was last loaded or played at.
+ *-----------------------------------------------------------------------*/
+void wavHotPlay(BYTE v)
+{
+    WAVVOICE* vp = &voices[v];
+#if hotClips
+    BYTE ie = PIE1bits.TMR2IE;
+
+    if (v >= hotClips || !hotCount[v])
+#endif
+    {
+        wavVoicePlay(v, vp->gain);
+        return;
+    }
+#if hotClips
+    PIE1bits.TMR2IE = 0;        // Hold off the ISR while it is set going
+    hotPos = hotEnd = hotBuf[v] + hotCount[v];
+    hotNext = hotBuf[v];
+    hotVoice = v;
+    vp->blk = ringTail;         // The block the attack starts with
+    PIE1bits.TMR2IE = ie;
+
+    vp->gain = hotGain[v];
+    vp->pos = 0;
+    vp->skip = hotCount[v];
+    vp->on = 1;
+#endif
+}
+
+/*-----------------------------------------------------------------------
+ * Stop voice 'v'.  Its clip stays loaded.
+ *-----------------------------------------------------------------------*/
+void wavVoiceStop(BYTE v)
+{
+#if hotClips
+    BYTE ie = PIE1bits.TMR2IE;
+#endif
+
+    voices[v].on = 0;
+#if hotClips
+    if (hotVoice == v) {
+        PIE1bits.TMR2IE = 0;
+        hotPos = hotEnd;        // Cut the attack short too
+        hotNext = 0;
+        PIE1bits.TMR2IE = ie;
+    }
+#endif
+}
+
+/*-----------------------------------------------------------------------
+ * Fill the block at ringHead with DAC words from the next bytes of the
+ * track, mix in the voices playing (see mixVoice) and hand it to the
+ * ISR.  The data is forwarded by pf_fread straight to the track's sink,
+ * or by flashRead for a clip in program flash.
+ * The block is cut short at the end of the track's samples, and
+ * trackSamples is 0 once they are all read.
+ *-----------------------------------------------------------------------*/
+static FRESULT fillBlock(void)
+{
+    FRESULT res;
+    BYTE i = ringHead & ringMask;
+    UINT len = nextLen;
+    UINT bReadCount;
+    WORD n;
+    WORD t = TMR3;
+    BYTE b;
+
+    if (len > trackBytes) len = (UINT)trackBytes;
+    fillPos = ring[i];
+    fillPhase = 0;
+    pf_forward(trackForward);
+    if (trackFlash) {
+        flashRead(trackFlash, len);
+        trackFlash += len;
+        bReadCount = len;
+    } else {
+        res = pf_fread(&trackFil, 0, len, &bReadCount);
+        if (res != 0) return res;           // File read error
+    }
+
+    // Count the samples off against the track
+    n = (WORD)(fillPos - ring[i]);
+    if (n > trackSamples) n = (WORD)trackSamples;
+    trackSamples -= n;
+    trackBytes -= bReadCount;
+    if (bReadCount < len || trackBytes == 0) trackSamples = 0;  // End of the data
+    nextLen = fillLen;
+
+    ringLen[i] = (BYTE)n;
+    if (n) {
+        res = mixQueued(ringHead + 1);
+        if (res != 0) return res;           // File read error
+    }
+
+    // Log the time the refill took [us]
+    t = TMR3 - t;
+    if (t > wavStats.refillMax) wavStats.refillMax = t;
+    for (b = 0, t >>= 8; t && b < refillBuckets - 1; t >>= 1) b++;
+    wavStats.refillHist[b]++;
+
+    if (n) {
+        ringStart[i] = trackStart;
+        if (trackStart) rateQueued = 1;     // The ISR switches to next* at this block
+        trackStart = 0;
+        ringHead++;                         // Block is now the ISR's
+    }
+    return FR_OK;
+}
+
+/*-----------------------------------------------------------------------
+ * Fill the next block of the ring.  Once the track is all read, open the
+ * next wav file in 'dir' instead, so it follows on without a gap, or set
+ * fillDone if there is none ('dir' is NULL to play a single file).  The
+ * next file isn't opened until the ISR has switched to the last one and
+ * playWav has announced it ('announce'), as its sample clock and name
+ * would be overwritten.  A file without samples is never heard, so it
+ * isn't announced.
+ *-----------------------------------------------------------------------*/
+static FRESULT refill(DIR* dir, FILINFO* fno, BYTE* announce)
+{
+    FRESULT res;
+
+    if (trackSamples) return fillBlock();
+    if (!dir) {
+        fillDone = 1;
+        return FR_OK;
+    }
+    if (trackStart) *announce = 0;          // It had no samples, nothing to say
+    if (rateQueued || *announce) return FR_OK;  // Try again later
+
+    res = nextWav(dir, fno);
+    if (res != FR_OK || fno->fname[0] == 0) {
+        fillDone = 1;                       // End of directory (or error)
+        return res;
+    }
+    *announce = 1;
+    return FR_OK;
+}
+
+/*-----------------------------------------------------------------------
+ * Print the telemetry of a track (see WAVSTATS).
+ *-----------------------------------------------------------------------*/
+void wavPrintStats(const WAVSTATS* st)
+{
+    BYTE i;
+
+    comPrintf("ISR cycles max %u avg %lu, %u underruns\n\r",
+            st->isrMax,
+            st->isrCount ? st->isrTotal / st->isrCount : 0,
+            st->underruns);
+    comPrintf("Ring low %u of %u blocks\n\r", st->ringLow, ringBlocks - 1);
+    if (st->mixLate) comPrintf("%u voice blocks mixed too late\n\r", st->mixLate);
+    comPrintf("Tick start %u..%u timer counts into the period\n\r",
+            st->tickLateMin, st->tickLateMax);
+    comPrintf("Refill max %u us, under 256 << n us:", st->refillMax);
+    for (i = 0; i < refillBuckets; i++) comPrintf(" %u", st->refillHist[i]);
+    comPrintf("\n\r");
+}
+
+/*-----------------------------------------------------------------------
+ * Print the telemetry of the track that just ended and start counting
+ * again for the next one, which is already playing.
+ *-----------------------------------------------------------------------*/
+static void restartStats(void)
+{
+    WAVSTATS last;
+
+    PIE1bits.TMR2IE = 0;        // Hold off the ISR while the counters are swapped
+    last = wavStats;
+    memset(&wavStats, 0, sizeof(wavStats));
+    wavStats.ringLow = ringBlocks;
+    wavStats.tickLateMin = 0xFF;
+    PIE1bits.TMR2IE = 1;
+    wavPrintStats(&last);
+}
+
 /*-----------------------------------------------------------------------
  * playWav should only be called after a successful openWav call, see
  *                  variable 'wavFormatGood'.
  *
- * playWav finds the beginning of the wav files data chunck, preemptively
- * loads both buffers and initiates playing by opening timer2.  Then
- * playWav goes into a while loop monitoring for end of file and the need
- * to refill a buffer.
+ * playWav preemptively fills the ring and initiates playing by starting
+ * timer2.  Then playWav goes into a while loop keeping the ring as full
+ * as it will go, so a slow card read only eats into the blocks already
+ * waiting.  When the file is all read, the next wav file in 'dir' is
+ * opened and read on into the ring while the last blocks play, and the
+ * ISR carries straight on into it.  Pass a NULL 'dir' to play just the
+ * one file.  Returns FR_WAV_END when everything has played.
  *-----------------------------------------------------------------------*/
-FRESULT playWav(void)
+FRESULT playWav(DIR* dir)
 {
     // if openWav hasn't been run successfully, dont try to play the file
     if (wavFormatGood != 1) {
@@ -219,145 +1352,223 @@ FRESULT playWav(void)
     }
 
     BYTE res;
-    UINT bReadCount;            // Number of bytes read
-    const UINT dataHeaderLen = 8;
-    struct {
-        BYTE id[4];     // Chunk ID
-        DWORD size;     // Chunk size
-    } header;
+    FILINFO fno;                // Next file from 'dir'
+    BYTE announce = 0;          // Set when the next file is to be announced
+    WAVVOICE* v;
 
-// <editor-fold defaultstate="collapsed" desc="Change sample rate">
-//    OpenADC(ADC_FOSC_4 & ADC_LEFT_JUST & ADC_4_TAD, ADC_CH0 & ADC_INT_OFF, ADC_REF_VDD_VSS);
-// </editor-fold>
-    // Read chunk headers until we are at the data chunk
-    while (1) {
-        res = pf_read(&header, dataHeaderLen, &bReadCount);
-        if (res != 0) return res;                   // File read error
-        if (bReadCount == dataHeaderLen             // check number of bytes read
-                && !strncmp(header.id, "data", 4))  // We are looking for the data chunk
-        {
-            // Stop reading headers and go fill those buffers!
-            printf("Data chunk size: %lu\n\r", header.size);
-            break;
-        } else {
-            // Chunk isn't 'data', jump over it and check next chunk
-            res = pf_jump(header.size);
-            if (res != 0) return res;
-        }
+    // Empty the ring.  The ISR picks up the first block on its first tick.
+    // Voices started already go on from its first block.
+    ringHead = ringTail = 0;
+    for (v = voices; v < voices + mixVoices; v++) v->blk = 0;
+    ringStarved = 0;
+    fillDone = 0;
+    rateQueued = 0;
+    playPos = playEnd = 0;
+
+    // Clear the telemetry and start its free running timers
+    memset(&wavStats, 0, sizeof(wavStats));
+    wavStats.ringLow = ringBlocks;
+    wavStats.tickLateMin = 0xFF;
+    OpenTimer1(TIMER_INT_OFF & T1_16BIT_RW & T1_SOURCE_FOSC_4 & T1_PS_1_1
+            & T1_OSC1EN_OFF & T1_SYNC_EXT_OFF, TIMER_GATE_OFF);
+    OpenTimer3(TIMER_INT_OFF & T3_16BIT_RW & T3_SOURCE_FOSC_4 & T3_PS_1_8
+            & T3_OSC1EN_OFF & T3_SYNC_EXT_OFF, TIMER_GATE_OFF);
+
+    // Prefill the ring from this file, leaving room for the block in play.
+    // Return FR_WAV_END if there are no samples at all.
+    while (trackSamples && ringHead < ringBlocks - 1) {
+        res = fillBlock();
+        if (res != 0) return res;               // File read error
     }
+    if (ringHead == 0) return FR_WAV_END;
 
-    // Atempt to fill buffer1.  Return res if read was not successful
-    // Return FR_WAV_END if zero bytes are read into buffer1
-    res = pf_read(&buffer1, bufflen, &bReadCount);
-    if (res != 0) return res;                   // File read error
-    if (bReadCount == 0) return FR_WAV_END;
-    // Set playPos as first index, and playEnd as last index of buffer1
-    playPos = buffer1;
-    playEnd = buffer1 + bReadCount;
-
-    // Atempt to fill buffer2.  Return res if read was not successful
-    res = pf_read(&buffer2, bufflen, &bReadCount);
-    if (res != 0) return res;                   // File read error
-    // Set playBuff as first index, and buffEnd as last index of buffer2
-    playBuff = buffer2;
-    buffEnd = buffer2 + bReadCount;
-    // Initialize status and bytesPlayed for beginning of file
-    status = SD_READY;
-    bytesPlayed = 0;
-
-    // Opening timer2 with interrupts begins the playing proccess!
-    // Initialize period regiter of timer2 with 180 for 22050 Hz
-    // playback.  Vaule verified emperically with Fosc = 32 MHz
-    OpenTimer2(TIMER_INT_ON & T2_PS_1_1 & T2_POST_1_2);
-    INTCON = 0xC0;          // Enable Peripheral and Global interrupts
-    PR2 = 180;          // Changing this alters playing rate!!!
+    // Starting timer2 with interrupts begins the playing proccess!
+    // Timer2 is set up for the file's sample rate by openWav, see
+    // setSampleRate.  The ISR keeps adjusting PR2 from then on.  The
+    // sample tick is the only high priority interrupt, so nothing else
+    // delays it (see init_COM).
+    TMR2 = 0;
+    PR2 = nextPR2;          // Changing this alters playing rate!!!
+    T2CON = nextT2CON;
+    PIR1bits.TMR2IF = 0;
+    IPR1bits.TMR2IP = 1;
+    PIE1bits.TMR2IE = 1;
+    INTCON = 0xC0;          // Enable high and low priority interrupts
 
     // This while loop keeps the music playing and buffers filling until the
-    // number of bytes played is equal to or great than the header size.
-    // The next buffer is filled based on the SD_FILLING flag, set in the ISR
-    // when the double buffers are switched.
+    // last file ran out and the ISR has played everything.  A block is
+    // filled whenever one is free; the block in play is never free.
     while (1) {
+        hostPoll();
         // <editor-fold defaultstate="collapsed" desc="Change sample rate">
         //SelChanConvADC(ADC_CH0);
         //char adc0 = (ReadADC()/273) + 160;
         //PR2 = adc0;
         // </editor-fold>
-        // If end of file, close timer2, set good return value and break while loop
-        if (bytesPlayed >= header.size) {
+        // If end of data, close timer2, set good return value and break while loop
+        if (fillDone && ringStarved && ringHead == ringTail) {
             CloseTimer2();
             res = FR_WAV_END;
             break;
         }
-        // SD_FILLING flag set in ISR
-        if (status == SD_FILLING) {
-            // swap double buffers
-            playBuff = playBuff != buffer1 ? buffer1 : buffer2;
-            res = pf_read(playBuff, bufflen, &bReadCount);  // Refill playBuff
-            if (res != 0) return res;                       // File read error
-            buffEnd = playBuff + bReadCount;        // more swapping logic
-            // clear flag so we wont be back here until another buffer is read
-            status = SD_READY;
+        // Once the ISR has moved on to the next file, say so.  Its first
+        // block is queued when trackStart clears, and taken by the ISR
+        // when rateQueued does.
+        if (announce && !trackStart && !rateQueued) {
+            restartStats();
+            comPrintf("Playing %s%s\n\r", fno.fname, pf_fcontig(&trackFil) ? "" : " (fragmented)");
+            announce = 0;
+        }
+        // Mix voices started since the last refill into the blocks waiting
+        res = mixQueued(ringHead);
+        if (res != 0) {                             // File read error
+            CloseTimer2();
+            return res;
+        }
+        // Top up the ring while there is a free block
+        if (!fillDone && (BYTE)(ringHead - ringTail) < ringBlocks - 1) {
+            res = refill(dir, &fno, &announce);
+            if (res != 0) {                         // File read error
+                CloseTimer2();
+                return res;
+            }
         }
     }
 
+    wavPrintStats(&wavStats);
     return res;
 }
 
 /*-----------------------------------------------------------------------
- *                         ******* ISR *******
- * First, checks for and handles double buffer swapping and sets flag to
- * refil buffer. Then, loads the current sample and sends it to DAC over a bit
- * bang SPI.  Also, increments bytes played counter (used to end file play).
+ * Play clip 'clip' of program flash (see flashClips.h) on its own, at its
+ * own sample rate, through the ring and ISR like a track.  Nothing is
+ * read from the card, so it plays before pf_mount, or with no card at
+ * all.  Voices playing are mixed over it.  Returns FR_WAV_END when it
+ * has played, like playWav.
  *-----------------------------------------------------------------------*/
-void interrupt dacInterrupt(void)
+FRESULT wavFlashPlay(BYTE clip)
 {
-    if (PIR1bits.TMR2IF) {
-        // Check if we're at the end of our playing buffer
-        if (playPos >= playEnd) {
-            // Swap double buffers and set flag to fill playBuff
-            playPos = playBuff;
-            playEnd = buffEnd;
-            status = SD_FILLING;
-            }
+    const WAVCLIP* c;
+    WAVINDEX* rec;
+    FRESULT res;
+
+    wavFormatGood = 0;
+    if (clip >= clipCount) return FR_NO_FILE;
+    c = &wavClips[clip];
+    rec = idxScratch();
+    rec->dataOfs = 0;
+    rec->samples = c->samples;
+    rec->dataLen = c->samples * (c->bits / 8);
+    rec->rate = c->rate;
+    rec->blockAlign = c->bits / 8;
+    rec->format = WAVE_FORMAT_PCM;
+    rec->bits = c->bits;
+    res = startTrack(rec);
+    if (res != FR_OK) return res;
+    trackFlash = c->data;
+    return playWav(0);
+}
+
+/*-----------------------------------------------------------------------
+ *                   ******* High priority ISR *******
+ * First, moves on to the next ring block when the current one is played
+ * out, or counts an underrun and holds the DAC if none is ready.  The
+ * first block of a track switches the sample clock to the track's rate,
+ * so tracks follow each other sample for sample.  Then, sets the length
+ * of this sample period, loads the current DAC word (already converted
+ * by the forwarding sinks) and sends it to DAC over a bit bang SPI, or MSSP2 (see
+ * DAC_USE_MSSP2 in waveReader.h).  Also, times itself for wavStats.
+ * Timer2 is the only high priority source, so there is no flag to test
+ * and nothing is called, which keeps the context save down to the fast
+ * register stack and the few temporaries used here.  The COM port log is
+ * sent by the low priority ISR, see comLog.c.
+ *-----------------------------------------------------------------------*/
+void interrupt high_priority dacInterrupt(void)
+{
+    BYTE late = TMR2;               // Counts into the period, for wavStats
+    WORD t0 = TMR1;                 // ISR start, for wavStats
+    WORD word;
+    BYTE sampleH, sampleL;
+
+    if (late > wavStats.tickLateMax) wavStats.tickLateMax = late;
+    if (late < wavStats.tickLateMin) wavStats.tickLateMin = late;
 
-        BYTE sampleH, sampleL;
-
-        // Load current sample to send to DAC, progress current sample position
-        // and bytes played counter by respective amounts
-        if (bitsPerSample == 16) {  // 16-bit sample
-            sampleH = 0x80 ^ playPos[1];    // 16-bit is signed
-            sampleL = playPos[0];
-            playPos += 2;                   // Move to next play position
-            bytesPlayed += 2;
-        } else {        // 8-bit samples
-            sampleH = playPos[0];           //8-bit is unsigned
-            sampleL = 0;
-            playPos += 1;                   // Move to next play position
-            bytesPlayed += 1;
+    // Check if we're at the end of our playing block
+    if (playPos >= playEnd) {
+        BYTE i = ringTail;
+        if (i == ringHead) {
+            // Ring is dry, hold the last sample until a block is ready
+            if (!fillDone) wavStats.underruns++;
+            ringStarved = 1;
+            PIR1bits.TMR2IF = 0;
+            return;
         }
+        // Take the next block.  Taking it frees the previous one.
+        playPos = ring[i & ringMask];
+        playEnd = playPos + ringLen[i & ringMask];
+        if (ringStart[i & ringMask]) {
+            // First block of a track, switch to its sample clock
+            T2CON = nextT2CON;
+            tickPR2 = nextPR2;
+            tickFrac = nextFrac;
+            tickRem = nextRem;
+            tickAcc = 0;
+            rateQueued = 0;
+        }
+#if hotClips
+        if (hotNext) {              // Start the attack wavHotPlay queued
+            hotPos = hotNext;
+            hotNext = 0;
+        }
+#endif
+        ringTail = ++i;
+        ringStarved = 0;
+        i = ringHead - i;                   // Full blocks still waiting
+        if (i < wavStats.ringLow && !fillDone) wavStats.ringLow = i;
+    }
 
-        dacCsLow();         // Active DAC with low chip select
-
-        dacSendZero();      // Address DAC A (not B)
-        dacSendZero();      // Use DAC in unbuffered mode
-        dacSendOne();       // 1X gain
-        dacSendOne();       // Not in shutdown mode
-        /* Send high 8 bits. */
-        dacSendBit(7, sampleH);
-        dacSendBit(6, sampleH);
-        dacSendBit(5, sampleH);
-        dacSendBit(4, sampleH);
-        dacSendBit(3, sampleH);
-        dacSendBit(2, sampleH);
-        dacSendBit(1, sampleH);
-        dacSendBit(1, sampleH);
-        /* Send low 4 bits, dropping the 4 LSbs. */
-        dacSendBit(7, sampleL);
-        dacSendBit(6, sampleL);
-        dacSendBit(5, sampleL);
-        dacSendBit(4, sampleL);
-
-        dacCsHigh();        // Chip select high - done
+    // Set the length of this sample period.  When the fractions of a
+    // count add up to a whole one, the period is a count longer.
+    if (tickAcc >= tickRem) {
+        tickAcc -= tickRem;
+        PR2 = tickPR2 + 1;
+    } else {
+        tickAcc += tickFrac;
+        PR2 = tickPR2;
+    }
+
+    // Load current DAC word and progress current sample position
+    word = playPos[0];
+    playPos++;                      // Move to next play position
+
+#if hotClips
+    // Mix in the attack of a hot clip, already scaled, see wavHotLoad
+    if (hotPos != hotEnd) {
+        SHORT m = (SHORT)(word & 0x0FFF) + *hotPos++ * 16;
+
+        if (m < 0) m = 0;
+        else if (m > 0x0FFF) m = 0x0FFF;
+        word = dacConfig | m;
+    }
+#endif
+    sampleH = word >> 8;
+    sampleL = word;
+
+    dacCsLow();         // Active DAC with low chip select
+
+    /* Send high 8 bits: DAC A, unbuffered, 1X gain, active and the
+     * top 4 data bits. */
+    dacSendByte(sampleH);
+    /* Send low 8 data bits. */
+    dacSendByte(sampleL);
+
+    dacCsHigh();        // Chip select high - done
+
+    // Log the cycles spent (not counting the context save)
+    t0 = TMR1 - t0;
+    if (t0 > wavStats.isrMax) wavStats.isrMax = t0;
+    wavStats.isrTotal += t0;
+    wavStats.isrCount++;
 
 // <editor-fold defaultstate="collapsed" desc="DEBUG - play middle C">
 //  Code used in debugging, plays a slightly flat middle C
@@ -386,7 +1597,6 @@ void interrupt dacInterrupt(void)
 //        dacCsHigh();        // Chip select high - done
 //        update = 1;
 // </editor-fold>
-        // Clear interrupt flag, now another interrupt can occur
-        PIR1bits.TMR2IF = 0;
-    }
+    // Clear interrupt flag, now another interrupt can occur
+    PIR1bits.TMR2IF = 0;
 }
\ No newline at end of file
@@ -14,13 +14,31 @@ extern "C" {
     
 #include "pff.h"
 
-#define bufflen 512
+#define instrFreq 8000000UL     // Instruction cycles per second (Fosc = 32 MHz)
+#define maxSampleRate 48000     // Fastest sample clock the ISR can keep up with
+#define minSampleRate (instrFreq / 16 / 256 + 1)    // Slowest sample clock Timer2 can make
+
+/* Sample data is played from a ring of ringBlocks blocks, each holding
+ * blockSamples DAC words.  A block is half a sector of 16-bit samples or
+ * a quarter sector of 8-bit samples, so refills stay sector aligned.
+ * ringBlocks must be a power of 2.  The ring takes 2 KB of RAM; with one
+ * block in play, up to 7 more are read ahead, about 40 ms at 22050 Hz. */
+#define ringBlocks 8
+#define blockSamples 128
+#define ringMask (ringBlocks - 1)
+
+#if ringBlocks & ringMask
+#error ringBlocks must be a power of 2
+#endif
+
+/* WAVE format tags handled by openWav. */
+#define WAVE_FORMAT_PCM 1
+#define WAVE_FORMAT_IMA_ADPCM 0x11
+#define WAVE_FORMAT_EXTENSIBLE 0xFFFE   // Format given by a sub format GUID
 
-typedef enum {
-    SD_LAST_BUFFER = 0,
-    SD_READY,
-    SD_FILLING
-} SDSTATUS;
+/* DAC command bits sent with every sample: DAC A, unbuffered, 1X gain,
+ * not in shutdown.  The 12-bit sample value fills the low bits. */
+#define dacConfig 0x3000
 
 // <editor-fold defaultstate="collapsed" desc="DEBUG - play middle C">
 //  Code used in debugging, plays a slightly flat middle C
@@ -44,7 +62,9 @@ typedef enum {
 
 #define dacSckLow() dacSck = 0
 #define dacSckHigh() dacSck = 1
+#ifndef dacSckPulse     // The host build clocks the bits into a mock
 #define dacSckPulse() {dacSckHigh(); dacSckLow();}
+#endif
 
 #define dacSdiSet(b) if(b) {dacSdi = 1;} else {dacSdi = 0;}
 
@@ -54,13 +74,168 @@ typedef enum {
 #define dacSendOne() {dacSdi = 1; dacSckPulse();}
 #define dacSendZero() {dacSdi = 0; dacSckPulse();}
 
+/* Set DAC_USE_MSSP2 to 1 to shift samples out with the MSSP2 hardware SPI
+ * instead of bit-banging them.  The shield's DAC SCK and SDI lines must
+ * then be jumpered to RD6 (SCK2) and RD4 (SDO2); chip select stays on RB0.
+ * At Fosc = 32 MHz a bit-banged sample costs about 130 instruction cycles
+ * of the 362 available per sample at 22050 Hz.  With MSSP2 at Fosc/4 each
+ * byte shifts out in 8 cycles, so a sample costs about 30.  The host
+ * build (host/Makefile) tries both against a mock of the DAC. */
+#ifndef DAC_USE_MSSP2
+#define DAC_USE_MSSP2 0
+#endif
+
+/* Send byte b to the DAC, MSb first. */
+#if DAC_USE_MSSP2
+#define dacSendByte(b) {PIR3bits.SSP2IF = 0; SSP2BUF = (b); while (!PIR3bits.SSP2IF);}
+#else
+#define dacSendByte(b) {dacSendBit(7, b); dacSendBit(6, b); dacSendBit(5, b); dacSendBit(4, b); \
+                        dacSendBit(3, b); dacSendBit(2, b); dacSendBit(1, b); dacSendBit(0, b);}
+#endif
+
+/* Playback telemetry, cleared when playWav starts a track and printed
+ * over the USART when it ends.  ISR times are instruction cycles from
+ * Timer1 and refill times are microseconds from Timer3 (1:8 prescaler),
+ * both free running.  isrTotal wraps after about 15 minutes of 22050 Hz
+ * playback and refills over 65 ms can't be timed.  Tick jitter is how
+ * far Timer2 had counted into the sample period when the ISR started,
+ * in Timer2 counts (1, 4 or 16 instruction cycles by the prescaler). */
+#define refillBuckets 8
+
+typedef struct {
+    WORD isrMax;            // Longest ISR run [cycles]
+    BYTE tickLateMin;       // Earliest ISR start in the sample period [Timer2 counts]
+    BYTE tickLateMax;       // Latest ISR start in the sample period [Timer2 counts]
+    DWORD isrTotal;         // Cycles of all timed ISR runs
+    DWORD isrCount;         // Number of timed ISR runs
+    WORD underruns;         // Sample periods the ring was dry
+    WORD mixLate;           // Voice blocks played before they could be mixed
+    BYTE ringLow;           // Fewest full blocks waiting (minimum slack)
+    WORD refillMax;         // Longest block refill [us]
+    WORD refillHist[refillBuckets]; // Refills under 256 << n us, the last counts the rest
+} WAVSTATS;
+
+extern WAVSTATS wavStats;
+
+/* Sound effect voices, mixed over the track block by block (see
+ * wavVoiceLoad and mixVoice).  A voice is a mono 8 or 16-bit PCM clip
+ * streamed from a file object of its own and played at the track's
+ * sample rate.  gain scales it, mixUnity being the clip's own level, and
+ * the sum is clipped to the DAC's range.  A clip can also come from
+ * program flash (see wavFlashVoice), which leaves the card alone.  Each
+ * voice has a map of its clip's cluster chain, like the track's, so the
+ * seek to a retriggered clip doesn't follow the FAT (up to 3 fragments,
+ * longer chains are followed as before).  A voice takes 57 bytes of RAM. */
+#ifndef mixVoices       // The host benchmark sets it to 8
+#define mixVoices 4
+#endif
+#define mixUnity 128
+#define voiceMapLen 8   // Items of a voice's cluster link map
+
+typedef struct {
+    FIL fil;                // Stream of the clip's samples
+    CLUST map[voiceMapLen]; // Cluster link map of fil
+    const BYTE* flash;      // Samples of a clip in program flash, 0 for a file
+    DWORD dataOfs;          // File offset of the first sample
+    DWORD samples;          // Samples in the clip
+    DWORD pos;              // Clip sample heard at the start of ring block 'blk'
+    WORD skip;              // Samples the ISR plays from RAM, see wavHotPlay
+    BYTE blk;               // Next ring block to mix into
+    BYTE bits;              // 8 or 16, 0 if no clip is loaded
+    BYTE gain;              // Level, mixUnity is 1
+    BYTE on;                // Set while the voice plays
+} WAVVOICE;
+
+/* Hot clips.  Voices below hotClips can keep the first hotLen samples of
+ * their clip in RAM, already scaled to the level they are loaded at (see
+ * wavHotLoad), so the ISR only has to add them.  They are kept to 8 bits,
+ * a DAC step of 16, which only the attack is heard at.  wavHotPlay has
+ * the ISR mix them in from the next block it takes, so the attack is
+ * heard within a block, while the rest of the clip is mixed from the card
+ * into the blocks after that one, which the card has at least a block's
+ * time to do.  The ISR plays one attack at a time.  A hot clip takes
+ * hotLen bytes of RAM; one fits beside the ring at 8 blocks.  With
+ * hotClips at 0, wavHotPlay starts the clip from the card like
+ * wavVoicePlay. */
+#ifndef hotClips        // The host test sets it to 2
+#define hotClips 1
+#endif
+#define hotLen blockSamples
+
+/* Clips in program flash, for boot chimes and error beeps that must play
+ * without the card.  flashClips.py makes wavClips and its ids (see
+ * flashClips.h) out of mono 8 or 16-bit PCM WAV files, with the samples
+ * kept as they are in the data chunk.  wavFlashPlay plays one on its own
+ * and wavFlashVoice mixes one over a track as a sound effect. */
+typedef struct {
+    const char* name;       // File the clip was made from
+    const BYTE* data;       // Samples, 16-bit ones low byte first
+    DWORD samples;          // Samples in the clip
+    WORD rate;              // Sample rate
+    BYTE bits;              // 8 or 16
+} WAVCLIP;
+
+extern const WAVCLIP wavClips[];
+
+/* Playlist index.  PLAYLIST.IDX in the root directory holds a WAVINDEX
+ * record for every file of the root directory, in directory order, after
+ * a WAVINDEXHDR.  With it a track starts with a seek straight to its
+ * samples instead of a read through its headers.  Records and header are
+ * 64 bytes, little endian, so a sector holds 8.  A record is only used
+ * while the size, date, time and start cluster of its directory entry
+ * still match; otherwise the index is stale and rootPlay rebuilds it with
+ * buildIndex.  Petit FatFs can't create or extend files, so the file must
+ * be made on the host, at 64 bytes for each file plus 64.  The device
+ * fills it in.  There is no RAM for a sector of records beside the ring,
+ * so they are read one at a time, in order. */
+#define idxFileName "PLAYLIST.IDX"
+#define idxMagic 0x58444957UL   // "WIDX"
+#define idxVersion 2
+#define idxWindow 1             // Records read from the index at a time
+
+typedef struct {
+    DWORD magic;            // idxMagic
+    WORD version;           // idxVersion
+    WORD count;             // Records after the header
+    BYTE full;              // Set if the file had no room for every record
+    BYTE pad[55];
+} WAVINDEXHDR;
+
+typedef struct {
+    DWORD fsize;            // Directory entry of the file when indexed
+    WORD fdate;
+    WORD ftime;
+    DWORD sclust;
+    DWORD dataOfs;          // File offset of the first sample
+    DWORD dataLen;          // Bytes of sample data
+    DWORD samples;          // Samples to play
+    DWORD rate;             // Sample rate
+    WORD blockAlign;        // Bytes in each IMA ADPCM block
+    BYTE format;            // WAVE_FORMAT_*, 0 if the file can't be played
+    BYTE bits;              // Bits per sample
+    DWORD smplOfs;          // File offset of the smpl chunk's contents, 0 if none
+    DWORD smplLen;          // Bytes of smpl chunk
+    DWORD cueOfs;           // File offset of the cue chunk's contents, 0 if none
+    DWORD cueLen;           // Bytes of cue chunk
+    BYTE pad[16];
+} WAVINDEX;
+
 /*---------------------------------------*/
 /* Prototypes for disk control functions */
 void put_rc (FRESULT rc);
 FRESULT rootPlay(void);
-FRESULT openWav(const char* fname);
-FRESULT playWav(void);
-void interrupt dacInterrupt(void);
+FRESULT openWav(const FILINFO* fno);
+FRESULT playWav(DIR* dir);
+FRESULT buildIndex(void);
+FRESULT wavVoiceLoad(BYTE v, const char* path);
+void wavVoicePlay(BYTE v, BYTE gain);
+void wavVoiceStop(BYTE v);
+FRESULT wavHotLoad(BYTE v, const char* path, BYTE gain);
+void wavHotPlay(BYTE v);
+FRESULT wavFlashPlay(BYTE clip);
+FRESULT wavFlashVoice(BYTE v, BYTE clip);
+void wavPrintStats(const WAVSTATS* st);
+void interrupt high_priority dacInterrupt(void);
 
 #ifdef	__cplusplus
 }